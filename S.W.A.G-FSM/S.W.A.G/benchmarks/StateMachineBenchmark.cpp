@@ -0,0 +1,242 @@
+// Compares the pooled, virtual StateMachine with the inline VariantStateMachine on dispatch and transition cost.
+// Standalone program, kept out of the game project. Build it with optimizations from this directory, for example:
+//   g++ -std=c++20 -O2 -I../include StateMachineBenchmark.cpp ../source/Utility/StateMachine.cpp -o StateMachineBenchmark
+//   cl /std:c++20 /O2 /EHsc /I..\include StateMachineBenchmark.cpp ..\source\Utility\StateMachine.cpp
+
+#include <Utility/VariantStateMachine.h>
+#include <Utility/StateMachine.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+#include <chrono>
+
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr int CallsPerRun = 2000000;
+	static constexpr int RunCount = 7;
+
+
+	// Data the states write to, standing in for the entity that owns the machine.
+	struct Owner
+	{
+		float timer = 0.0f;
+
+		int enterCount = 0;
+	};
+
+
+	// States shaped like the real ones, holding the owner and a few fields, once as virtual States for the pooled machine.
+	struct PooledGrazing : State
+	{
+		explicit PooledGrazing(Owner* owner) : owner(owner) {}
+
+		void Enter() override { owner->enterCount++; }
+		void Tick(float deltaTime) override { owner->timer += deltaTime; elapsed += deltaTime; }
+		void Exit() override { owner->timer *= 0.5f; }
+
+		Owner* owner;
+
+		float elapsed = 0.0f;
+		float target = 0.0f;
+		int steps = 0;
+	};
+
+	struct PooledFleeing : State
+	{
+		explicit PooledFleeing(Owner* owner) : owner(owner) {}
+
+		void Enter() override { owner->enterCount++; }
+		void Tick(float deltaTime) override { owner->timer -= deltaTime; target += deltaTime; }
+		void Exit() override { owner->timer *= 0.5f; }
+
+		Owner* owner;
+
+		float elapsed = 0.0f;
+		float target = 0.0f;
+		int steps = 0;
+	};
+
+	struct PooledResting : State
+	{
+		explicit PooledResting(Owner* owner) : owner(owner) {}
+
+		void Enter() override { owner->enterCount++; }
+		void Tick(float deltaTime) override { owner->timer += 2.0f * deltaTime; steps++; }
+		void Exit() override { owner->timer *= 0.5f; }
+
+		Owner* owner;
+
+		float elapsed = 0.0f;
+		float target = 0.0f;
+		int steps = 0;
+	};
+
+
+	// The same states as plain structs for the variant machine.
+	struct InlineGrazing
+	{
+		explicit InlineGrazing(Owner* owner) : owner(owner) {}
+
+		void Enter() { owner->enterCount++; }
+		void Tick(float deltaTime) { owner->timer += deltaTime; elapsed += deltaTime; }
+		void Exit() { owner->timer *= 0.5f; }
+
+		Owner* owner;
+
+		float elapsed = 0.0f;
+		float target = 0.0f;
+		int steps = 0;
+	};
+
+	struct InlineFleeing
+	{
+		explicit InlineFleeing(Owner* owner) : owner(owner) {}
+
+		void Enter() { owner->enterCount++; }
+		void Tick(float deltaTime) { owner->timer -= deltaTime; target += deltaTime; }
+		void Exit() { owner->timer *= 0.5f; }
+
+		Owner* owner;
+
+		float elapsed = 0.0f;
+		float target = 0.0f;
+		int steps = 0;
+	};
+
+	struct InlineResting
+	{
+		explicit InlineResting(Owner* owner) : owner(owner) {}
+
+		void Enter() { owner->enterCount++; }
+		void Tick(float deltaTime) { owner->timer += 2.0f * deltaTime; steps++; }
+		void Exit() { owner->timer *= 0.5f; }
+
+		Owner* owner;
+
+		float elapsed = 0.0f;
+		float target = 0.0f;
+		int steps = 0;
+	};
+
+
+	struct PooledMachine : StateMachine
+	{
+		Owner owner;
+	};
+
+	struct InlineMachine : VariantStateMachine<InlineGrazing, InlineFleeing, InlineResting>
+	{
+		Owner owner;
+	};
+
+
+	// Switches a pooled machine to one of the three states.
+	void SwitchPooled(PooledMachine& machine, int kind)
+	{
+		switch (kind)
+		{
+		case 0: machine.SwitchState<PooledGrazing>(&machine.owner); break;
+		case 1: machine.SwitchState<PooledFleeing>(&machine.owner); break;
+		default: machine.SwitchState<PooledResting>(&machine.owner); break;
+		}
+	}
+
+	// Switches a variant machine to one of the three states.
+	void SwitchInline(InlineMachine& machine, int kind)
+	{
+		switch (kind)
+		{
+		case 0: machine.SwitchState<InlineGrazing>(&machine.owner); break;
+		case 1: machine.SwitchState<InlineFleeing>(&machine.owner); break;
+		default: machine.SwitchState<InlineResting>(&machine.owner); break;
+		}
+	}
+
+	// Returns the best time per call in nanoseconds over several runs of the body, which makes the given number of calls.
+	template<typename Body>
+	double MeasureBest(double callCount, Body&& body)
+	{
+		double best = 1e300;
+
+		for (int run = 0; run < RunCount; run++)
+		{
+			Clock::time_point start = Clock::now();
+
+			body();
+
+			double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+			best = std::min(best, elapsed / callCount);
+		}
+
+		return best;
+	}
+
+	// Runs both machines over the given number of entities, with states mixed across them and visited in shuffled order.
+	void RunBenchmark(int machineCount)
+	{
+		int rounds = std::max(1, CallsPerRun / machineCount);
+
+		std::vector<std::unique_ptr<PooledMachine>> pooled;
+		std::vector<std::unique_ptr<InlineMachine>> inlined;
+		std::vector<int> order(machineCount);
+
+		std::mt19937 random(1);
+
+		for (int i = 0; i < machineCount; i++)
+		{
+			int kind = static_cast<int>(random() % 3);
+
+			pooled.push_back(std::make_unique<PooledMachine>());
+			inlined.push_back(std::make_unique<InlineMachine>());
+
+			SwitchPooled(*pooled.back(), kind);
+			SwitchInline(*inlined.back(), kind);
+
+			order[i] = i;
+		}
+
+		std::shuffle(order.begin(), order.end(), random);
+
+		uint64_t heapAllocationsBefore = StateAllocationStats::heapAllocations.load();
+		uint64_t pooledReusesBefore = StateAllocationStats::pooledReuses.load();
+
+		double callCount = static_cast<double>(machineCount) * rounds;
+
+		double pooledDispatch = MeasureBest(callCount, [&]() { for (int r = 0; r < rounds; r++) for (int i : order) pooled[i]->Update(0.016f); });
+		double inlineDispatch = MeasureBest(callCount, [&]() { for (int r = 0; r < rounds; r++) for (int i : order) inlined[i]->Update(0.016f); });
+		double pooledTransition = MeasureBest(callCount, [&]() { for (int r = 0; r < rounds; r++) for (int i : order) SwitchPooled(*pooled[i], (r + i) % 3); });
+		double inlineTransition = MeasureBest(callCount, [&]() { for (int r = 0; r < rounds; r++) for (int i : order) SwitchInline(*inlined[i], (r + i) % 3); });
+
+		float checksum = 0.0f;
+
+		for (int i = 0; i < machineCount; i++)
+		{
+			checksum += pooled[i]->owner.timer + inlined[i]->owner.timer;
+		}
+
+		printf("%8d  %14.1f ns  %9.1f ns  %16.1f ns  %9.1f ns  %12llu  %12llu  (%g)\n", machineCount, pooledDispatch, inlineDispatch, pooledTransition, inlineTransition,
+			static_cast<unsigned long long>(StateAllocationStats::heapAllocations.load() - heapAllocationsBefore),
+			static_cast<unsigned long long>(StateAllocationStats::pooledReuses.load() - pooledReusesBefore), checksum);
+	}
+}
+
+
+// Prints the time per call of both machines, best of several runs, for growing numbers of entities.
+int main()
+{
+	printf("machines  dispatch pooled   variant       transition pooled   variant       heap allocs   pool reuses\n");
+
+	for (int machineCount : { 1000, 10000, 100000 })
+	{
+		RunBenchmark(machineCount);
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -13,9 +13,9 @@ public:
 	virtual ~Entity() = default;
 
 	virtual void Update(float deltaTime);
-	virtual void Draw() = 0;
 
-	// Sense-Decide-Act Pattern
+	// Sense-Decide-Act Pattern, with Perceive as the read-only part of sensing that may run on any thread
+	virtual void Perceive() {}
 	virtual void Sense(float deltaTime) = 0;
 	virtual void Decide(float deltaTime) = 0;
 	virtual void Act(float deltaTime) = 0;
@@ -24,6 +24,9 @@ public:
 	Vector2 GetPosition() const { return position; }
 
 
+	bool IsSenseDue(float deltaTime) const { return senseTimer + deltaTime >= senseInterval; }
+
+
 	bool IsAlive() const { return isAlive; }
 
 protected:
@@ -1,16 +1,13 @@
 #pragma once
 
-#include <Utility/State.h>
-
 
 class GrassStateMachine;
 
 
-class GrassBaseState : public State
+class GrassBaseState
 {
 public:
     GrassBaseState(GrassStateMachine* stateMachine);
-    virtual ~GrassBaseState() = default;
 
 protected:
     GrassStateMachine* grassStateMachine;
@@ -1,8 +1,10 @@
 #pragma once
 
-#include <Utility/StateMachine.h>
+#include <Entities/Grass/States/GrassStates.h>
+#include <Utility/VariantStateMachine.h>
 #include <Utility/ValueConfig.h>
 #include <Entities/Entity.h>
+#include <World/EntityHandles.h>
 
 #include <raylib.h>
 
@@ -10,7 +12,7 @@
 class World;
 
 
-class GrassStateMachine : public Entity, public StateMachine
+class GrassStateMachine : public Entity, public VariantStateMachine<SeedsPlantedState, FullyGrownState, WiltingState>
 {
 public:
     enum class GrassState
@@ -20,7 +22,7 @@ public:
         Wilting
     };
 
-    GrassStateMachine(World* world, Vector2 position, float scaleFactor = 1.0f);
+    GrassStateMachine(World* world, Vector2 position);
     ~GrassStateMachine();
 
     void Initialize();
@@ -28,48 +30,35 @@ public:
     void Sense(float deltaTime) override;
     void Decide(float deltaTime) override;
     void Act(float deltaTime) override;
-    void Draw() override;
 
     void SpreadSeeds();
+    void UpdateEdibility();
     void Die();
 
 
     GrassState GetCurrentState() const { return currentGrassState; }
+    GrassHandle GetHandle() const { return handle; }
+    int GetGrowthStage() const;
     Vector2 GetPosition() const { return position; }
 
     void SetCurrentState(GrassState state) { currentGrassState = state; }
-    void SetBeingEaten(bool value) { isBeingEaten = value; }
+    void SetHandle(GrassHandle value) { handle = value; }
+    void SetBeingEaten(bool value) { isBeingEaten = value; UpdateEdibility(); }
 
+    bool IsEdible() const { return isAlive && currentGrassState == GrassState::FullyGrown && !isBeingEaten; }
     bool IsBeingEaten() const { return isBeingEaten; }
     bool IsAlive() const { return isAlive; }
 
-
-    static void CleanupTextures();
-
 private:
-    static void LoadTextures();
-    static void UnloadTextures();
-
-
     GrassState currentGrassState;
+    GrassHandle handle;
     World* world;
 
 
     Vector2 position;
 
 
-    static Texture2D seedsPlantedTextures[6]; 
-    static Texture2D fullyGrownTexture;       
-    static Texture2D wiltingTexture;
-
-
-    float scaleFactor;
-
     bool isAlive;
     bool isBeingEaten = false;
-
-    static bool texturesLoaded;
-
-
-    static constexpr float cellSize = ValueConfig::World::CellSize;
-};
+    bool isIndexedAsEdible = false;
+};
\ No newline at end of file
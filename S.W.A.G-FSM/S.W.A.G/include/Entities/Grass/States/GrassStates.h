@@ -2,7 +2,6 @@
 
 #include <Entities/Grass/BaseState/GrassBaseState.h>
 #include <Utility/SimulationConfig.h>
-#include <Utility/StateMachine.h>
 
 
 class SeedsPlantedState : public GrassBaseState
@@ -10,9 +9,9 @@ class SeedsPlantedState : public GrassBaseState
 public:
 	SeedsPlantedState(GrassStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 
 	float GetGrowthTimer() const { return growthTimer; }
@@ -26,9 +25,9 @@ class FullyGrownState : public GrassBaseState
 public:
 	FullyGrownState(GrassStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float spreadTimer;
@@ -40,9 +39,9 @@ class WiltingState : public GrassBaseState
 public:
 	WiltingState(GrassStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float wiltingTimer;
@@ -1,14 +1,13 @@
-#include <Utility/State.h>
+#pragma once
 
 
 class SheepStateMachine;
 
 
-class SheepBaseState : public State
+class SheepBaseState
 {
 public:
     SheepBaseState(SheepStateMachine* stateMachine);
-    virtual ~SheepBaseState() = default;
 
 protected:
     SheepStateMachine* sheepStateMachine;
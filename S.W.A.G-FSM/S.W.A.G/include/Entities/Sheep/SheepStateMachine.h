@@ -1,114 +1,105 @@
 #pragma once
 
+#include <Entities/Sheep/States/SheepStates.h>
 #include <Utility/SimulationConfig.h>
-#include <Utility/StateMachine.h>
+#include <Utility/VariantStateMachine.h>
 #include <Utility/ValueConfig.h>
 #include <Entities/Entity.h>
+#include <World/EntityHandles.h>
+#include <World/FlockRegistry.h>
+#include <World/SheepStore.h>
 
 #include <raylib.h>
 
-#include <unordered_set>
 #include <vector>
 #include <memory>
 
 
 class World;
 class WolfStateMachine;
+class GrassStateMachine;
 
 
-class SheepStateMachine : public Entity, public StateMachine
+class SheepStateMachine : public Entity, public VariantStateMachine<WanderingAloneState, WanderingInGroupState, SheepEatingState, DefecatingState, RunningAwayState, ReproducingState>
 {
 public:
-	enum class SheepState
-	{
-		WanderingAlone,
-		WanderingInGroup,
-		Eating,
-		Defecating,
-		RunningAway,
-		Reproducing
-	};
+	using SheepState = SheepActivity;
 
-	SheepStateMachine(World* world, Vector2 position, float scaleFactor = 1.0f);
+	SheepStateMachine(World* world, Vector2 position);
 	~SheepStateMachine();
 
 	void Initialize();
 
+	void Perceive() override;
 	void Sense(float deltaTime) override;
 	void Decide(float deltaTime) override;
 	void Act(float deltaTime) override;
-	void Draw() override;
 
-	void RemoveFromGroup(SheepStateMachine* sheep);
-	void AddToGroup(SheepStateMachine* sheep);
+	void UpdateVitals(float deltaTime);
 	void RequestNewSheep(Vector2 position);
 	void SetPosition(Vector2 newPosition);
 	void LeaveGroup();
 
 
-	void SetHealth(float value) { health = std::min(value, RuntimeConfig::SheepMaxHealth()); if (health <= 0) { Die(); } }
-	void SetFullness(float value) { fullness = std::min(value, RuntimeConfig::SheepMaxFullness()); }
-	void SetNewSheepPositions(std::vector<Vector2>* positions) { newSheepPositions = positions; }
-	void SetHunger(float value) { hunger = std::min(value, RuntimeConfig::SheepMaxHunger()); }
-	void SetGroupLeader(SheepStateMachine* leader) { groupLeader = leader; }
+	void SetHealth(float value) { store->SetHealth(storeSlot, std::min(value, RuntimeConfig::SheepMaxHealth())); if (GetHealth() <= 0) { Die(); } }
+	void SetFullness(float value) { store->SetFullness(storeSlot, std::min(value, RuntimeConfig::SheepMaxFullness())); }
+	void SetHunger(float value) { store->SetHunger(storeSlot, std::min(value, RuntimeConfig::SheepMaxHunger())); }
+	void SetDesiredVelocity(Vector2 velocity) { store->SetVelocity(storeSlot, velocity); }
 	void SetGroupCooldownTimer(float value) { groupCooldownTimer = value; }
-	void SetCurrentState(SheepState state) { currentSheepState = state; }
+	void SetCurrentState(SheepState state) { store->SetActivity(storeSlot, state); }
 	void SetIsReproducing(bool value) { isReproducing = value; }
+	void SetHandle(SheepHandle value) { handle = value; }
+	void SetStoreSlot(size_t slot) { storeSlot = slot; }
 
 	float GetGroupCooldownTimer() const { return groupCooldownTimer; }
-	float GetGroupTimer() const { return groupTimer; }
-	float GetFullness() const { return fullness; }
-	float GetHunger() const { return hunger; }
-	float GetHealth() const { return health; }
+	float GetFullness() const { return store->GetFullness(storeSlot); }
+	float GetHunger() const { return store->GetHunger(storeSlot); }
+	float GetHealth() const { return store->GetHealth(storeSlot); }
 
-	const std::unordered_set<SheepStateMachine*>& GetGroupMembers() const { return groupMembers; }
+	const Flock* GetFlock() const;
 
-	Vector2 GetPosition() const { return position; }
+	Vector2 GetPosition() const { return store->GetPosition(storeSlot); }
 
-	SheepStateMachine* GetGroupLeader() const { return groupLeader; }
-	SheepState GetCurrentState() const { return currentSheepState; }
-	size_t GetGroupSize() const { return groupMembers.size() + 1; }
+	SheepStateMachine* GetGroupLeader() const;
+	SheepState GetCurrentState() const { return store->GetActivity(storeSlot); }
+	SheepHandle GetHandle() const { return handle; }
+	int32_t GetGroupId() const { return store->GetGroupId(storeSlot); }
+	size_t GetStoreSlot() const { return storeSlot; }
+	size_t GetGroupSize() const { const Flock* flock = GetFlock(); return flock ? flock->count : 1; }
 	World* GetWorld() const { return world; }
 
 
-	void UpdateGroupTimer(float deltaTime) { groupTimer += deltaTime; }
-	void ResetGroupTimer() { groupTimer = 0.0f; }
-	void Die() { isAlive = false; }
+	void Die();
 
-	bool IsInGroup() const { return groupLeader != nullptr || !groupMembers.empty(); }
-	bool IsGroupLeader() const { return !groupMembers.empty(); }
+	bool IsInGroup() const { return GetGroupId() != SheepStore::NoGroup; }
+	bool IsGroupLeader() const { const Flock* flock = GetFlock(); return flock && flock->GetLeader() == handle; }
 	bool IsReproducing() const { return isReproducing; }
 	bool IsAlive() const { return isAlive; }
 
 private:
-	void DrawStatusBars(Vector2 barPosition, float healthValue, float hungerValue);
-
-	const WolfStateMachine* nearestWolf;
-	SheepStateMachine* groupLeader;
-	SheepState currentSheepState;
-	World* world;
-
-
-	Texture2D sheepTexture;
-
+	// What the sheep saw in its last perception pass, left for Sense to act on.
+	struct Perception
+	{
+		WolfHandle nearestWolf;
+		SheepHandle closestSheep;
+	};
 
-	std::unordered_set<SheepStateMachine*> groupMembers;
+	const WolfStateMachine* FindNearestWolf(Vector2 center) const;
+	GrassStateMachine* FindEdibleGrass(Vector2 center) const;
 
-	std::vector<Vector2>* newSheepPositions;
+	Perception perception;
+	SheepHandle handle;
+	WolfHandle nearestWolf;
+	SheepStore* store;
+	World* world;
 
 
-	Vector2 position;
 	Vector2 moveDirection;
 
+	size_t storeSlot;
+
 	bool isAlive;
 	bool isReproducing;
 
-	float health;
-	float hunger;
-	float fullness;
-	float groupTimer;
-	float scaleFactor;
 	float groupCooldownTimer = 0.0f;
-
-	static constexpr float cellSize = ValueConfig::World::CellSize;
 };
\ No newline at end of file
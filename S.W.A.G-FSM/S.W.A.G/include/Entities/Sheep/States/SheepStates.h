@@ -1,16 +1,16 @@
 #pragma once
 
 #include <Entities/Sheep/BaseState/SheepBaseState.h>
-#include <Entities/Grass/GrassStateMachine.h>
 #include <Utility/SimulationConfig.h>
-#include <Utility/StateMachine.h>
 #include <Utility/ValueConfig.h>
+#include <World/EntityHandles.h>
 
 
 #include <raylib.h>
 
 
 class SheepStateMachine;
+class GrassStateMachine;
 
 
 class WanderingAloneState : public SheepBaseState
@@ -18,9 +18,9 @@ class WanderingAloneState : public SheepBaseState
 public:
 	WanderingAloneState(SheepStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float movementTimer;
@@ -37,9 +37,9 @@ class WanderingInGroupState : public SheepBaseState
 public:
 	WanderingInGroupState(SheepStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float movementTimer;
@@ -55,16 +55,16 @@ private:
 class SheepEatingState : public SheepBaseState
 {
 public:
-	SheepEatingState(SheepStateMachine* stateMachine);
+	SheepEatingState(SheepStateMachine* stateMachine, GrassStateMachine* targetGrass);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float eatingTimer;
 
-	GrassStateMachine* targetGrass;
+	GrassHandle targetGrass;
 
 	static constexpr float timeToEat = ValueConfig::Sheep::TimeToEat;
 };
@@ -74,9 +74,9 @@ class DefecatingState : public SheepBaseState
 public:
 	DefecatingState(SheepStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float defecatingTimer;
@@ -89,14 +89,11 @@ class RunningAwayState : public SheepBaseState
 public:
 	RunningAwayState(SheepStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
-	Vector2 CalculateEdgeAvoidance(const Vector2& position);
-
-
 	Vector2 randomDirectionOffset;
 
 	float escapeDirectionTimer;
@@ -114,9 +111,9 @@ class ReproducingState : public SheepBaseState
 public:
 	ReproducingState(SheepStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float reproducingTimer;
@@ -1,16 +1,13 @@
 #pragma once
 
-#include <Utility/State.h>
-
 
 class WolfStateMachine;
 
 
-class WolfBaseState : public State
+class WolfBaseState
 {
 public:
     WolfBaseState(WolfStateMachine* stateMachine);
-    virtual ~WolfBaseState() = default;
 
 protected:
     WolfStateMachine* wolfStateMachine;
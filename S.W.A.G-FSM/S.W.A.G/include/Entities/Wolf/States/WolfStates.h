@@ -1,7 +1,6 @@
 #pragma once
 
 #include <Entities/Wolf/BaseState/WolfBaseState.h>
-#include <Utility/StateMachine.h>
 #include <Utility/ValueConfig.h>
 
 #include <raylib.h>
@@ -12,9 +11,9 @@ class SleepingState : public WolfBaseState
 public:
 	SleepingState(WolfStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float sleepTimer;
@@ -27,9 +26,9 @@ class RoamingState : public WolfBaseState
 public:
 	RoamingState(WolfStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float movementTimer;
@@ -44,9 +43,9 @@ class HuntingState : public WolfBaseState
 public:
 	HuntingState(WolfStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	Vector2 CalculateWolfSeparation();
@@ -66,9 +65,9 @@ class WolfEatingState : public WolfBaseState
 public:
 	WolfEatingState(WolfStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	float eatingTimer;
@@ -81,9 +80,9 @@ class ReturnToDenState : public WolfBaseState
 public:
 	ReturnToDenState(WolfStateMachine* stateMachine);
 
-	void Enter() override;
-	void Tick(float deltaTime) override;
-	void Exit() override;
+	void Enter();
+	void Tick(float deltaTime);
+	void Exit();
 
 private:
 	static constexpr float returnSpeed = ValueConfig::Wolf::ReturnSpeed; 
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <Entities/Wolf/States/WolfStates.h>
 #include <Utility/SimulationConfig.h>
-#include <Utility/StateMachine.h>
+#include <Utility/VariantStateMachine.h>
 #include <Utility/ValueConfig.h>
 #include <Entities/Entity.h>
+#include <World/EntityHandles.h>
 
 #include <raylib.h>
 
@@ -12,7 +14,7 @@ class World;
 class SheepStateMachine;
 
 
-class WolfStateMachine : public Entity, public StateMachine
+class WolfStateMachine : public Entity, public VariantStateMachine<SleepingState, RoamingState, HuntingState, WolfEatingState, ReturnToDenState>
 {
 public:
 	enum class WolfState
@@ -24,25 +26,25 @@ public:
 		ReturnToDen
 	};
 
-	WolfStateMachine(World* world, Vector2 position, float scaleFactor = 1.0f);
+	WolfStateMachine(World* world, Vector2 position);
 	~WolfStateMachine();
 
 	void Initialize();
 
+	void Perceive() override;
 	void Sense(float deltaTime) override;
 	void Decide(float deltaTime) override;
 	void Act(float deltaTime) override;
-	void Draw() override;
 
 
-	void DrawStatusBars(Vector2 barPosition, float staminaValue);
+	void SetTargetSheep(SheepStateMachine* sheep);
 	void SetPosition(Vector2 newPosition);
-	void DrawHuntingLine();
-	void FindNewTarget();
 
 
-	void SetTargetSheep(SheepStateMachine* sheep) { targetSheep = sheep; }
+	void SetDesiredVelocity(Vector2 velocity) { desiredVelocity = velocity; }
 	void SetCurrentState(WolfState state) { currentWolfState = state; }
+	void SetHandle(WolfHandle value) { handle = value; }
+	void SetDenIndex(int value) { denIndex = value; }
 	void SetStamina(float value) { stamina = value; }
 	void SetHunger(float value) { hunger = value; }
 
@@ -50,41 +52,46 @@ public:
 	float GetStamina() const { return stamina; }
 	float GetHunger() const { return hunger; }
 
+	Vector2 GetDesiredVelocity() const { return desiredVelocity; }
 	Vector2 GetPosition() const { return position; }
 
-	SheepStateMachine* GetTargetSheep() const { return targetSheep; }
+	SheepStateMachine* GetTargetSheep() const;
 	WolfState GetCurrentState() const { return currentWolfState; }
+	WolfHandle GetHandle() const { return handle; }
+	int GetDenIndex() const { return denIndex; }
 	World* GetWorld() const { return world; }
 
 
 	bool IsTired() const { return stamina < tiredThreshold; }
 	bool IsAlive() const { return isAlive; }
 
-	void Die() { isAlive = false; }
+	void Die();
 
 private:
-	SheepStateMachine* targetSheep;
+	SheepStateMachine* FindNewTarget() const;
+
 	WolfState currentWolfState;
+	SheepHandle targetSheep;
+	SheepHandle perceivedTarget;
+	WolfHandle handle;
 	World* world;
 
 
 	Vector2 position;
-
-
-	Texture2D wolfTexture;
+	Vector2 desiredVelocity = { 0.0f, 0.0f };
 
 
 	bool isAlive;
 
+	int denIndex = -1;
+
 	float hunger;
 	float stamina;
-	float scaleFactor;
 	float targetingTimer;
 
 	const float tiredThreshold = RuntimeConfig::WolfStaminaMax() * 0.2f;
 	const float hungerThreshold = RuntimeConfig::WolfHungerThreshold();
 
 	static constexpr float targetAcquisitionDelay = 0.5f;
-	static constexpr float cellSize = ValueConfig::World::CellSize;
 	static constexpr float staminaRecoveryRate = ValueConfig::Wolf::StaminaRecoveryRate;
 };
\ No newline at end of file
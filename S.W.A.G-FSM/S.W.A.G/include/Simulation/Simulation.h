@@ -1,11 +1,17 @@
 #pragma once
 
 #include <Utility/SimulationConfig.h>
+#include <Utility/TripleBuffer.h>
 #include <Utility/ValueConfig.h>
+#include <World/RenderSnapshot.h>
+#include <World/WorldRenderer.h>
 #include <World/World.h>
 
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
+#include <mutex>
 
 
 class SimulationConfig;
@@ -36,16 +42,14 @@ public:
 	void Run();
 
 
-	Vector2 GetViewportMaxCoordinates() const { return Vector2{ simulationViewport.width - ValueConfig::World::CellSize * screenScaleFactor, simulationViewport.height - ValueConfig::World::CellSize * screenScaleFactor }; }
+	Vector2 GetViewportMaxCoordinates() const { return Vector2{ simulationViewport.width - cellSize * screenScaleFactor, simulationViewport.height - cellSize * screenScaleFactor }; }
 
 	float GetViewportHeight() const { return simulationViewport.height; }
 	float GetViewportWidth() const { return simulationViewport.width; }
 	float GetViewportYOffset() const { return simulationViewport.y; }
 
 
-	void AddConsoleMessage(const std::string& message) { consoleMessages.push_back(message); }
-
-	bool ShouldShowDetectionRadii() const { return showDetectionRadii; }
+	void AddConsoleMessage(const std::string& message);
 
 private:
 	void Initialize();
@@ -54,6 +58,9 @@ private:
 
 	void InitializeImGui();
 	void StartSimulation();
+	void StopSimulation();
+	void RunSimulationThread();
+	void TakeConsoleMessages();
 	void ShutdownImGui();
 	void DrawSetupUI();
 
@@ -62,6 +69,7 @@ private:
 	void RenderWolfSettings();
 
 	void RenderSimulationInViewport();
+	void UpdateWorldCamera();
 	void UpdateValidScalingOptions();
 	void DrawEntityStatusWindow();
 	void DrawSimulationLayout();
@@ -87,6 +95,8 @@ private:
 	Viewport simulationViewport;
 	SimulationConfig config;
 
+	Camera2D worldCamera = { { 0.0f, 0.0f }, { 0.0f, 0.0f }, 0.0f, 1.0f };
+
 
 	int screenWidth;
 	int screenHeight;
@@ -102,6 +112,7 @@ private:
 
 	float cellSize;
 	float screenScaleFactor = 1.0f;
+	float viewZoom = 1.0f;
 
 	bool showEntityStatus = true;
 	bool showDetectionRadii = false;
@@ -116,7 +127,16 @@ private:
 
 
 	std::unique_ptr<World> world;
+	std::unique_ptr<WorldRenderer> worldRenderer;
+
+	TripleBuffer<RenderSnapshot> snapshots;
+
+	std::thread simulationThread;
+	std::atomic<bool> simulationRunning = false;
 
 
 	std::vector<std::string> consoleMessages;
+	std::vector<std::string> pendingConsoleMessages;
+
+	std::mutex consoleMutex;
 };
@@ -1,21 +1,19 @@
 #pragma once
 
-#include <Utility/ValueConfig.h>
-
 #include <raylib.h>
 
 
 namespace CoordinateUtils
 {
-	// Converts grid coordinates to world space coordinates
-	inline Vector2 GridToWorldPosition(Vector2 gridPos, float scaleFactor = 1.0f)
+	// Converts grid coordinates to world space coordinates, given the world's cell size
+	inline Vector2 GridToWorldPosition(Vector2 gridPos, float cellSize)
 	{
-		return { gridPos.x * ValueConfig::World::CellSize * scaleFactor, gridPos.y * ValueConfig::World::CellSize * scaleFactor };
+		return { gridPos.x * cellSize, gridPos.y * cellSize };
 	}
 
-	// Converts world space coordinates to grid coordinates
-	inline Vector2 WorldToGridPosition(Vector2 worldPos, float scaleFactor = 1.0f)
+	// Converts world space coordinates to grid coordinates, given the world's cell size
+	inline Vector2 WorldToGridPosition(Vector2 worldPos, float cellSize)
 	{
-		return { worldPos.x / ValueConfig::World::CellSize * scaleFactor, worldPos.y / ValueConfig::World::CellSize * scaleFactor };
+		return { worldPos.x / cellSize, worldPos.y / cellSize };
 	}
 }
\ No newline at end of file
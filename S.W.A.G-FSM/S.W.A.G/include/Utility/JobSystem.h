@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Number of submitted jobs that have not finished yet, which Wait blocks on until it reaches zero.
+using JobCounter = std::atomic<size_t>;
+
+
+// Small work-stealing scheduler. Every thread taking part, the one that created it included, has its own deque of jobs.
+// A thread works on the newest job of its own deque and, once that runs dry, steals the oldest job of another thread.
+// Threads waiting on a counter keep running jobs meanwhile, so jobs may submit and wait on further jobs without deadlocking.
+class JobSystem
+{
+public:
+	using Job = std::function<void()>;
+	using RangeTask = std::function<void(size_t begin, size_t end)>;
+
+	explicit JobSystem(unsigned int workerCount = DefaultWorkerCount());
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	void Submit(Job job, JobCounter& counter);
+	void Wait(const JobCounter& counter);
+
+	void ParallelFor(size_t count, size_t grainSize, const RangeTask& task);
+
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(queues.size()); }
+
+	static unsigned int DefaultWorkerCount();
+	static unsigned int GetCurrentThreadIndex();
+
+private:
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	void WorkerLoop(unsigned int threadIndex);
+
+	bool TryRunJob(unsigned int threadIndex);
+	bool PopJob(unsigned int threadIndex, Job& job);
+	bool StealJob(unsigned int threadIndex, Job& job);
+
+
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> workers;
+
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+
+	std::atomic<size_t> queuedJobs = 0;
+
+	bool stopping = false;
+};
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Utility/JobSystem.h>
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+
+// Steps of a frame declared together with the steps they have to wait for.
+// Running the graph starts every step whose dependencies are done as its own job, so steps that do not depend on each other overlap.
+class PhaseGraph
+{
+public:
+	using PhaseId = int;
+
+	PhaseId AddPhase(std::function<void()> work, std::initializer_list<PhaseId> dependencies = {});
+
+	void Run(JobSystem& jobs);
+
+private:
+	struct Phase
+	{
+		std::function<void()> work;
+		std::vector<PhaseId> dependents;
+
+		int dependencyCount = 0;
+	};
+
+	void Schedule(JobSystem& jobs, PhaseId id, JobCounter& counter);
+
+
+	std::vector<Phase> phases;
+	std::vector<std::atomic<int>> pendingDependencies;
+};
\ No newline at end of file
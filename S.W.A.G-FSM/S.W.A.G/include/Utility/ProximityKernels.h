@@ -0,0 +1,20 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstddef>
+#include <cstdint>
+
+
+// Distance kernels over packed x and y coordinate arrays, comparing squared distances only.
+// They use AVX2, SSE or NEON when the compiler targets them and a scalar loop otherwise, and all paths return identical results.
+namespace ProximityKernels
+{
+	static constexpr size_t NotFound = SIZE_MAX;
+
+	// Returns the index of the point nearest to the center among those strictly closer than the limit, or NotFound. Ties go to the lowest index.
+	size_t FindNearest(const float* positionsX, const float* positionsY, size_t count, Vector2 center, float maxDistanceSquared);
+
+	// Sets mask[i] to 1 for every point strictly within the radius and to 0 for every other, returning how many points are within.
+	size_t MaskWithinRadius(const float* positionsX, const float* positionsY, size_t count, Vector2 center, float radiusSquared, uint8_t* mask);
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+
+// Small deterministic random number generator for work that must not draw from raylib's shared sequence, such as sheep updating on several threads at once.
+class Random
+{
+public:
+	void Seed(uint64_t seed) { state = seed; }
+
+	int GetValue(int min, int max);
+
+private:
+	uint64_t Next();
+
+
+	uint64_t state = 0;
+};
\ No newline at end of file
@@ -22,6 +22,10 @@ public:
 	int initialSheepCount = ValueConfig::World::InitialSheepCount;
 	int initialWolfCount = ValueConfig::World::InitialWolfCount;
 
+	int workerThreadCount = -1;
+	bool parallelSense = true;
+	bool domainDecomposition = true;
+
 	EntityTab currentTab = EntityTab::Main;
 
 	// Grass configuration values.
@@ -49,6 +53,7 @@ public:
 		float grassDetectionRadius = ValueConfig::Sheep::GrassDetectionRadius;
 		float groupRadius = ValueConfig::Sheep::GroupRadius;
 		int maxGroupSize = ValueConfig::Sheep::MaxGroupSize;
+		bool sharedFlockPerception = true;
 	} sheepConfig;
 
 
@@ -91,6 +96,7 @@ namespace RuntimeConfig
 	inline float SheepGrassDetectionRadius() { return Config.sheepConfig.grassDetectionRadius; }
 	inline float SheepGroupRadius() { return Config.sheepConfig.groupRadius; }
 	unsigned inline int SheepMaxGroupSize() { return Config.sheepConfig.maxGroupSize; }
+	inline bool SheepSharedFlockPerception() { return Config.sheepConfig.sharedFlockPerception; }
 
 	// Wolf.
 	inline float WolfMaxHunger() { return Config.wolfConfig.maxHunger; }
@@ -107,4 +113,7 @@ namespace RuntimeConfig
 	inline int WorldInitialGrassCount() { return Config.initialGrassCount; }
 	inline int WorldInitialSheepCount() { return Config.initialSheepCount; }
 	inline int WorldInitialWolfCount() { return Config.initialWolfCount; }
+	inline int WorldWorkerThreadCount() { return Config.workerThreadCount; }
+	inline bool WorldParallelSense() { return Config.parallelSense; }
+	inline bool WorldDomainDecomposition() { return Config.domainDecomposition; }
 }
\ No newline at end of file
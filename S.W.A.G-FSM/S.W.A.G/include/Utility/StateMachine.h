@@ -2,7 +2,39 @@
 
 #include <Utility/State.h>
 
-#include <memory>
+#include <utility>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <new>
+
+
+// Counters shared by every state pool, used to measure how many transitions still reach the heap.
+struct StateAllocationStats
+{
+    static inline std::atomic<uint64_t> heapAllocations = 0;
+    static inline std::atomic<uint64_t> pooledReuses = 0;
+};
+
+
+// Per-thread free list of raw storage for one state type, so transitions back into that type reuse memory instead of allocating.
+template<typename TState>
+class StatePool
+{
+public:
+    static void* Allocate();
+    static void Release(State* state);
+
+private:
+    struct FreeList
+    {
+        ~FreeList();
+
+        std::vector<void*> blocks;
+    };
+
+    static FreeList& GetFreeList();
+};
 
 
 class StateMachine
@@ -11,10 +43,86 @@ public:
     StateMachine();
     virtual ~StateMachine();
 
-    void SwitchState(std::unique_ptr<State> newState);
+    StateMachine(const StateMachine&) = delete;
+    StateMachine& operator=(const StateMachine&) = delete;
+
+    template<typename TState, typename... Args>
+    void SwitchState(Args&&... args);
 
     void Update(float deltaTime);
 
 protected:
-    std::unique_ptr<State> currentState;
+    State* currentState;
+
+private:
+    void (*releaseCurrentState)(State*);
 };
+
+
+// Returns the free list of the calling thread for this state type.
+template<typename TState>
+typename StatePool<TState>::FreeList& StatePool<TState>::GetFreeList()
+{
+    thread_local FreeList freeList;
+
+    return freeList;
+}
+
+// Hands out storage for one state, recycled from a previous state of the same type whenever possible.
+template<typename TState>
+void* StatePool<TState>::Allocate()
+{
+    FreeList& freeList = GetFreeList();
+
+    if (!freeList.blocks.empty())
+    {
+        void* block = freeList.blocks.back();
+        freeList.blocks.pop_back();
+
+        StateAllocationStats::pooledReuses.fetch_add(1, std::memory_order_relaxed);
+
+        return block;
+    }
+
+    StateAllocationStats::heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    return ::operator new(sizeof(TState));
+}
+
+// Destroys a state and keeps its storage for the next state of the same type.
+template<typename TState>
+void StatePool<TState>::Release(State* state)
+{
+    TState* typedState = static_cast<TState*>(state);
+    typedState->~TState();
+
+    GetFreeList().blocks.push_back(typedState);
+}
+
+// Frees the storage cached by a thread once that thread ends.
+template<typename TState>
+StatePool<TState>::FreeList::~FreeList()
+{
+    for (void* block : blocks)
+    {
+        ::operator delete(block);
+    }
+}
+
+// Handles the transition between states, building the new state in pooled storage and recycling the old one.
+template<typename TState, typename... Args>
+void StateMachine::SwitchState(Args&&... args)
+{
+    State* newState = new (StatePool<TState>::Allocate()) TState(std::forward<Args>(args)...);
+
+    if (currentState)
+    {
+        currentState->Exit();
+        releaseCurrentState(currentState);
+    }
+
+    currentState = newState;
+    releaseCurrentState = &StatePool<TState>::Release;
+
+    currentState->Enter();
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <unordered_map>
+#include <functional>
+#include <string_view>
+#include <string>
+#include <vector>
+
+
+class TextureCache;
+
+
+// Shared reference to a texture owned by a TextureCache, the texture stays loaded while any handle points to it.
+class TextureHandle
+{
+public:
+	TextureHandle() = default;
+	TextureHandle(const TextureHandle& other);
+	TextureHandle(TextureHandle&& other) noexcept;
+	~TextureHandle();
+
+	TextureHandle& operator=(TextureHandle other) noexcept;
+
+	const Texture2D& Get() const;
+
+	bool IsValid() const { return cache != nullptr; }
+
+private:
+	friend class TextureCache;
+
+	TextureHandle(TextureCache* cache, size_t slot) : cache(cache), slot(slot) {}
+
+
+	TextureCache* cache = nullptr;
+
+	size_t slot = 0;
+};
+
+
+// Loads each texture file once and shares it between every handle that asks for the same path.
+class TextureCache
+{
+public:
+	TextureCache() = default;
+	~TextureCache();
+
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	TextureHandle Acquire(std::string_view path);
+
+	size_t GetLoadedCount() const { return texturesByPath.size(); }
+
+private:
+	friend class TextureHandle;
+
+	struct Entry
+	{
+		std::string path;
+
+		Texture2D texture;
+
+		int referenceCount;
+	};
+
+	struct PathHash
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::string_view path) const { return std::hash<std::string_view>{}(path); }
+	};
+
+	void AddReference(size_t slot) { entries[slot].referenceCount++; }
+	void Release(size_t slot);
+
+
+	std::unordered_map<std::string, size_t, PathHash, std::equal_to<>> texturesByPath;
+
+	std::vector<Entry> entries;
+	std::vector<size_t> freeSlots;
+};
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+
+// Hands values from one writer thread to one reader thread without either ever waiting on the other.
+// The writer fills its own buffer and publishes it, the reader picks up the newest published buffer, and the third buffer sits in between.
+// Buffers are reused rather than reallocated, so values holding vectors keep their capacity from one round to the next.
+template<typename T>
+class TripleBuffer
+{
+public:
+	T& GetWriteBuffer() { return buffers[writeIndex]; }
+	const T& GetReadBuffer() const { return buffers[readIndex]; }
+
+	void Publish();
+	bool Acquire();
+
+private:
+	static constexpr uint8_t IndexMask = 0x3;
+	static constexpr uint8_t FreshFlag = 0x4;
+
+
+	std::array<T, 3> buffers;
+
+	std::atomic<uint8_t> middle = 1;
+
+	uint8_t writeIndex = 0;
+	uint8_t readIndex = 2;
+};
+
+
+// Swaps the finished write buffer into the middle, marked as fresh, and continues with whichever buffer was there before.
+template<typename T>
+void TripleBuffer<T>::Publish()
+{
+	writeIndex = middle.exchange(static_cast<uint8_t>(writeIndex | FreshFlag), std::memory_order_acq_rel) & IndexMask;
+}
+
+// Takes the middle buffer if something was published since the last call, returning whether the read buffer changed.
+template<typename T>
+bool TripleBuffer<T>::Acquire()
+{
+	if ((middle.load(std::memory_order_relaxed) & FreshFlag) == 0)
+	{
+		return false;
+	}
+
+	readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & IndexMask;
+
+	return true;
+}
\ No newline at end of file
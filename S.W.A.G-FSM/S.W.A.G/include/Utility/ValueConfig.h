@@ -47,6 +47,10 @@ namespace ValueConfig
 		static constexpr float GrassDetectionRadius = 65.0f;	  // Distance at which grass is detected.
 		static constexpr float GroupRadius = 100.0f;			  // Distance for considering sheep as grouped.
 		static constexpr int MaxGroupSize = 5;					  // Maximum number of sheep in a group.
+		static constexpr int FlockCapacity = 10;				  // Hard limit on group size, the room every flock reserves inline.
+		static constexpr int PerceptionCapacity = 16;			  // Wolves and grass a flock can remember per shared sense pass.
+		static constexpr float PerceptionInterval = 0.5f;		  // Time between shared flock sense passes.
+		static constexpr float PerceptionMargin = 40.0f;		  // Extra radius covering member movement between sense passes.
 
 
 		static constexpr float TimeToEat = 3.5f;				  // Time it takes to eat grass.
@@ -60,14 +64,41 @@ namespace ValueConfig
 		static constexpr float PanicSpeedMultiplier = 1.3f;		  // Speed boost when panicking.
 		static constexpr float GroupCooldownAfterFleeing = 10.0f; // Time in seconds before sheep can join groups after fleeing.
 		static constexpr float SheepHungerThreshold = 0.45f;	  // Hunger percentage that triggers eating (45%).
+		static constexpr float PoopContaminationRadius = 64.0f;   // Distance around droppings in which grass is avoided.
 	}
 
 	// General World Configuration.
 	namespace World
 	{
 		static constexpr float CellSize = 32.0f;				  // Size of each cell in the grid.
+		static constexpr float EdgeMargin = 4.0f;				  // Gap kept between moving entities and the far edges of the world.
 		static constexpr int InitialGrassCount = 15;			  // Starting number of grass.
 		static constexpr int InitialSheepCount = 12;			  // Starting number of sheep.
 		static constexpr int InitialWolfCount = 2;				  // Starting number of wolves.
+
+		static constexpr float SpatialBucketSize = 128.0f;		  // Size of each bucket in the sheep and wolf spatial grids.
+		static constexpr int ParallelBatchSize = 64;			  // Entities handed to a worker thread per job.
+
+		static constexpr int DomainCount = 8;					  // Most vertical strips the sheep update is split into.
+		static constexpr float DomainRebalanceTolerance = 0.25f;  // Share of extra sheep a strip takes before the edges move.
+
+		static constexpr int PoopParticleCapacity = 256;		  // Maximum number of droppings shown at once.
+		static constexpr int BloodParticleCapacity = 1024;		  // Maximum number of blood splatters shown at once.
+		static constexpr float PoopLifetime = 10.0f;			  // Time droppings stay visible and keep grass contaminated.
+		static constexpr float BloodSplatterLifetime = 5.0f;	  // Time blood splatters stay visible.
+
+		static constexpr float CullMargin = 64.0f;				  // Extra distance around the view that is still drawn.
+
+		static constexpr float TickInterval = 1.0f / 60.0f;		  // Fixed time step the simulation thread advances the world by.
+		static constexpr int MaxCatchUpTicks = 5;				  // Most ticks run back to back after falling behind, the rest of the backlog is dropped.
+	}
+
+	// Camera Configuration.
+	namespace Camera
+	{
+		static constexpr float MinZoom = 0.1f;					  // Furthest the view can zoom out.
+		static constexpr float MaxZoom = 4.0f;					  // Furthest the view can zoom in.
+		static constexpr float ZoomStep = 1.1f;					  // Zoom factor applied per mouse wheel notch.
+		static constexpr float DetailZoomThreshold = 0.4f;		  // On-screen scale below which status bars and group lines are left out.
 	}
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+
+// State machine that stores its states inline in a std::variant and dispatches with std::visit, so states need no heap or virtual calls.
+// Transitions requested while a state is running are applied once that state returns, so a state is never destroyed mid-call.
+template<typename... States>
+class VariantStateMachine
+{
+public:
+	VariantStateMachine() = default;
+	~VariantStateMachine();
+
+	VariantStateMachine(const VariantStateMachine&) = delete;
+	VariantStateMachine& operator=(const VariantStateMachine&) = delete;
+
+	template<typename TState, typename... Args>
+	void SwitchState(Args&&... args);
+
+	void Update(float deltaTime);
+	void Shutdown();
+
+
+	template<typename TState>
+	const TState* GetState() const { return std::get_if<TState>(&currentState); }
+
+	template<typename TState>
+	bool IsInState() const { return std::holds_alternative<TState>(currentState); }
+
+private:
+	using StateStorage = std::variant<std::monostate, States...>;
+
+	template<typename Function>
+	static void Visit(StateStorage& storage, Function&& function);
+
+	void ApplyPendingState();
+
+
+	StateStorage currentState;
+	StateStorage pendingState;
+
+	bool isDispatching = false;
+};
+
+
+// Exits the current state if one is still active.
+template<typename... States>
+VariantStateMachine<States...>::~VariantStateMachine()
+{
+	Shutdown();
+}
+
+// Builds the next state in place and enters it, or queues it until the running state has returned.
+template<typename... States>
+template<typename TState, typename... Args>
+void VariantStateMachine<States...>::SwitchState(Args&&... args)
+{
+	pendingState.template emplace<TState>(std::forward<Args>(args)...);
+
+	if (!isDispatching)
+	{
+		ApplyPendingState();
+	}
+}
+
+// Processes the current state's tick function with the given time delta, then applies any transition it requested.
+template<typename... States>
+void VariantStateMachine<States...>::Update(float deltaTime)
+{
+	isDispatching = true;
+
+	Visit(currentState, [deltaTime](auto& state) { state.Tick(deltaTime); });
+
+	isDispatching = false;
+
+	ApplyPendingState();
+}
+
+// Exits the current state and leaves the machine empty, dropping any transition the exit requested.
+// Owners whose states read data the owner's destructor frees call this first, so the state still exits against a whole owner.
+template<typename... States>
+void VariantStateMachine<States...>::Shutdown()
+{
+	isDispatching = true;
+
+	Visit(currentState, [](auto& state) { state.Exit(); });
+
+	currentState.template emplace<std::monostate>();
+	pendingState.template emplace<std::monostate>();
+
+	isDispatching = false;
+}
+
+// Calls the function with the active alternative, skipping the empty state.
+template<typename... States>
+template<typename Function>
+void VariantStateMachine<States...>::Visit(StateStorage& storage, Function&& function)
+{
+	std::visit([&function](auto& state)
+	{
+		if constexpr (!std::is_same_v<std::decay_t<decltype(state)>, std::monostate>)
+		{
+			function(state);
+		}
+	}, storage);
+}
+
+// Exits the current state and replaces it with the queued one, repeating while Exit or Enter queue further transitions.
+template<typename... States>
+void VariantStateMachine<States...>::ApplyPendingState()
+{
+	isDispatching = true;
+
+	while (!std::holds_alternative<std::monostate>(pendingState))
+	{
+		Visit(currentState, [](auto& state) { state.Exit(); });
+
+		Visit(pendingState, [this](auto& nextState)
+		{
+			currentState.template emplace<std::decay_t<decltype(nextState)>>(std::move(nextState));
+		});
+
+		pendingState.template emplace<std::monostate>();
+
+		Visit(currentState, [](auto& state) { state.Enter(); });
+	}
+
+	isDispatching = false;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <World/EntityHandles.h>
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+
+enum class ParticleKind : uint8_t
+{
+	Poop,
+	Blood
+};
+
+// Takes health off a sheep, which dies once it has none left.
+struct DamageSheepCommand
+{
+	SheepHandle sheep;
+	float amount;
+};
+
+// Has a sheep wandering alone join the group of another sheep, or start a new group with it.
+struct JoinGroupCommand
+{
+	SheepHandle sheep;
+	SheepHandle other;
+};
+
+// Adds a newborn sheep at the position once the dead of the tick are gone.
+struct SpawnSheepCommand
+{
+	Vector2 position;
+};
+
+// Leaves droppings or a blood splatter at the position.
+struct SpawnParticleCommand
+{
+	ParticleKind kind;
+	Vector2 position;
+};
+
+// Makes a group member take part in its group's reproduction, or releases it once the group is done.
+struct SetReproducingCommand
+{
+	SheepHandle sheep;
+	bool reproducing;
+};
+
+using WorldAction = std::variant<DamageSheepCommand, JoinGroupCommand, SpawnSheepCommand, SpawnParticleCommand, SetReproducingCommand>;
+
+// A deferred change to the world, tagged with the entity that issued it and its place among that entity's commands.
+struct WorldCommand
+{
+	uint64_t issuer;
+	uint32_t sequence;
+
+	WorldAction action;
+};
+
+
+// Changes that entities updated on one thread want to make to other entities or to the world, recorded during the tick.
+// The world merges every thread's buffer in issuer order and applies them at the end of the tick, so the result does not depend on scheduling.
+class CommandBuffer
+{
+public:
+	void SetIssuer(uint64_t value) { issuer = value; sequence = 0; }
+
+	void DamageSheep(SheepHandle sheep, float amount) { Push(DamageSheepCommand{ sheep, amount }); }
+	void JoinGroup(SheepHandle sheep, SheepHandle other) { Push(JoinGroupCommand{ sheep, other }); }
+	void SpawnSheep(Vector2 position) { Push(SpawnSheepCommand{ position }); }
+	void SpawnParticle(ParticleKind kind, Vector2 position) { Push(SpawnParticleCommand{ kind, position }); }
+	void SetReproducing(SheepHandle sheep, bool reproducing) { Push(SetReproducingCommand{ sheep, reproducing }); }
+
+	const std::vector<WorldCommand>& GetCommands() const { return commands; }
+
+	void Clear() { commands.clear(); }
+
+private:
+	void Push(WorldAction action) { commands.push_back({ issuer, sequence++, action }); }
+
+
+	std::vector<WorldCommand> commands;
+
+	uint64_t issuer = 0;
+	uint32_t sequence = 0;
+};
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <vector>
+
+
+// Wolf dens of the world, each with a flow field that points every grid cell along the shortest path home around blocked cells.
+// Fields are only rebuilt after a den was added or the terrain changed, so returning wolves just read a cached direction.
+class DenRegistry
+{
+public:
+	DenRegistry() = default;
+
+	DenRegistry(const DenRegistry&) = delete;
+	DenRegistry& operator=(const DenRegistry&) = delete;
+
+	void Initialize(float maxX, float maxY, float size);
+
+	int AddDen(Vector2 position);
+	void SetBlocked(Vector2 position, bool blocked);
+	void RebuildIfDirty();
+
+	Vector2 GetDirectionHome(int denIndex, Vector2 position) const;
+	Vector2 GetPosition(int denIndex) const { return dens[denIndex].position; }
+
+	int FindNearest(Vector2 position) const;
+	int GetCount() const { return static_cast<int>(dens.size()); }
+
+private:
+	struct Den
+	{
+		Vector2 position;
+
+		std::vector<float> cost;
+		std::vector<float> directionX;
+		std::vector<float> directionY;
+	};
+
+	void BuildFlowField(Den& den);
+
+	int CellIndex(Vector2 position) const;
+
+	Vector2 CellCenter(int cellX, int cellY) const { return { (cellX + 0.5f) * cellSize, (cellY + 0.5f) * cellSize }; }
+
+
+	std::vector<Den> dens;
+	std::vector<uint8_t> blocked;
+
+
+	int columns = 1;
+	int rows = 1;
+
+	float cellSize = 1.0f;
+
+	bool dirty = false;
+};
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+
+// Splits the world into vertical strips, one per domain, whose edges always fall between the columns of the spatial grids.
+// A rebalance moves the edges so every strip holds about the same number of entities, but only once a strip drifted far enough from its share to be worth it.
+class DomainDecomposition
+{
+public:
+	static constexpr int Boundary = -1;
+
+	DomainDecomposition() = default;
+
+	DomainDecomposition(const DomainDecomposition&) = delete;
+	DomainDecomposition& operator=(const DomainDecomposition&) = delete;
+
+	void Initialize(float maxX, float width, int domainCount, float minDomainWidth);
+	void Rebalance(const std::vector<float>& positionsX, float tolerance);
+
+	int FindDomain(float minX, float maxX) const;
+	int GetDomainCount() const { return static_cast<int>(edges.size()) - 1; }
+
+	float GetMinX(int domain) const { return edges[domain] * columnWidth; }
+	float GetMaxX(int domain) const { return edges[domain + 1] * columnWidth; }
+
+private:
+	int ColumnOf(float x) const;
+
+
+	// First column of every strip, followed by the column count, so strip i covers the columns from edges[i] up to edges[i + 1].
+	std::vector<int> edges;
+	std::vector<int> loadBefore;
+
+
+	int columns = 1;
+	int minColumns = 1;
+
+	float columnWidth = 1.0f;
+};
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <World/SlotMap.h>
+
+
+class GrassStateMachine;
+class SheepStateMachine;
+class WolfStateMachine;
+
+
+using GrassHandle = EntityHandle<GrassStateMachine>;
+using SheepHandle = EntityHandle<SheepStateMachine>;
+using WolfHandle = EntityHandle<WolfStateMachine>;
\ No newline at end of file
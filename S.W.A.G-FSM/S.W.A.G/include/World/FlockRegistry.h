@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Utility/ValueConfig.h>
+#include <World/EntityHandles.h>
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <vector>
+#include <array>
+
+
+class World;
+
+
+// Wolves and edible grass seen by a flock during its last shared sense pass, gathered around the centroid with a radius that covers every member.
+// Members filter it against their own position and radius instead of querying the world themselves.
+struct FlockPerception
+{
+	std::array<WolfHandle, ValueConfig::Sheep::PerceptionCapacity> wolves;
+	std::array<GrassHandle, ValueConfig::Sheep::PerceptionCapacity> grass;
+	std::array<Vector2, ValueConfig::Sheep::PerceptionCapacity> grassPositions;
+
+	int wolfCount = 0;
+	int grassCount = 0;
+
+	// Cleared when sharing is off, the flock changed since the last pass, or more was seen than fits, in which case members query on their own.
+	bool valid = false;
+};
+
+
+// One group of sheep with its members held inline. The first member is the leader, the rest follow it in joining order.
+struct Flock
+{
+	std::array<SheepHandle, ValueConfig::Sheep::FlockCapacity> members;
+	std::array<Vector2, ValueConfig::Sheep::FlockCapacity> separation;
+
+	FlockPerception perception;
+
+	Vector2 centroid = { 0.0f, 0.0f };
+
+	int count = 0;
+
+	float radius = 0.0f;
+	float reproductionTimer = 0.0f;
+	float perceptionTimer = ValueConfig::Sheep::PerceptionInterval;
+
+	bool readyToReproduce = false;
+	bool active = false;
+
+	const SheepHandle* begin() const { return members.data(); }
+	const SheepHandle* end() const { return members.data() + count; }
+
+	SheepHandle GetLeader() const { return members[0]; }
+
+	Vector2 GetSeparation(SheepHandle member) const;
+};
+
+
+// Owns every sheep group of the world. A sheep's group id in the sheep store is the index of its flock here.
+// Flock-wide work such as splitting off stragglers, member separation, reproduction timing and sensing runs once per flock rather than once per member.
+class FlockRegistry
+{
+public:
+	explicit FlockRegistry(World* world) : world(world) {}
+
+	FlockRegistry(const FlockRegistry&) = delete;
+	FlockRegistry& operator=(const FlockRegistry&) = delete;
+
+	int32_t Create(SheepStateMachine* leader, SheepStateMachine* follower);
+	bool Join(int32_t flockId, SheepStateMachine* sheep);
+	void Leave(SheepStateMachine* sheep);
+	void Update(float deltaTime);
+
+	void ResetReproductionTimer(int32_t flockId);
+	void Recycle(int32_t flockId) { freeFlocks.push_back(flockId); }
+
+	const Flock* Get(int32_t flockId) const;
+
+	size_t GetFlockCount() const { return flocks.size() - freeFlocks.size(); }
+
+private:
+	void Perceive(Flock& flock);
+	void RemoveMember(int32_t flockId, int index);
+	void Dissolve(int32_t flockId);
+	void SetGroupId(SheepStateMachine* sheep, int32_t flockId);
+
+
+	std::vector<Flock> flocks;
+	std::vector<int32_t> freeFlocks;
+
+	World* world;
+};
\ No newline at end of file
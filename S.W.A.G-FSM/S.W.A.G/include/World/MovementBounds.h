@@ -0,0 +1,17 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <algorithm>
+
+
+// Rectangle the top-left corner of a moving entity is kept inside, worked out once by the world instead of on every move.
+struct MovementBounds
+{
+	float minX = 0.0f;
+	float minY = 0.0f;
+	float maxX = 0.0f;
+	float maxY = 0.0f;
+
+	Vector2 Clamp(Vector2 position) const { return { std::max(minX, std::min(position.x, maxX)), std::max(minY, std::min(position.y, maxY)) }; }
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <vector>
+
+
+struct ParticleSnapshot;
+
+
+// Fixed-capacity ring buffer of short-lived circles that all share one lifetime, stored as parallel arrays.
+// Particles expire in spawn order, so expiry only advances the head, and spawning into a full buffer replaces the oldest particle.
+class ParticleSystem
+{
+public:
+	ParticleSystem(size_t capacity, float lifetime);
+
+	void Spawn(Vector2 position, float radius, Color color);
+	void Update(float deltaTime);
+	void WriteSnapshot(std::vector<ParticleSnapshot>& particles) const;
+
+	size_t GetCapacity() const { return positionX.size(); }
+	size_t GetCount() const { return count; }
+
+private:
+	size_t Wrap(size_t index) const { return index < GetCapacity() ? index : index - GetCapacity(); }
+
+
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> radius;
+	std::vector<float> spawnTime;
+	std::vector<Color> color;
+
+
+	size_t head = 0;
+	size_t count = 0;
+
+	float lifetime;
+	float elapsedTime = 0.0f;
+};
\ No newline at end of file
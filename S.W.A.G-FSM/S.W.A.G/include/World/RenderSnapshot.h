@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Entities/Grass/GrassStateMachine.h>
+#include <Entities/Wolf/WolfStateMachine.h>
+#include <World/SheepStore.h>
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <vector>
+
+
+struct GrassSnapshot
+{
+	Vector2 cell;
+
+	GrassStateMachine::GrassState state;
+
+	uint8_t growthStage;
+
+	bool beingEaten;
+};
+
+struct SheepSnapshot
+{
+	Vector2 position;
+
+	float health;
+	float hunger;
+
+	// Index of the group leader within the snapshot's sheep, or -1 for sheep that are alone or lead their group.
+	int32_t leader;
+
+	SheepActivity activity;
+
+	bool inGroup;
+	bool groupLeader;
+	bool reproducing;
+};
+
+struct WolfSnapshot
+{
+	Vector2 position;
+	Vector2 targetPosition;
+
+	float hunger;
+	float stamina;
+
+	WolfStateMachine::WolfState state;
+
+	bool hasTarget;
+	bool tired;
+};
+
+struct ParticleSnapshot
+{
+	Vector2 position;
+
+	float radius;
+
+	Color color;
+};
+
+
+// Everything the window needs to draw the world and list its entities, copied out by the simulation thread after a tick.
+// It holds plain values only, so the render thread can read it while the simulation thread keeps changing the world.
+struct RenderSnapshot
+{
+	std::vector<GrassSnapshot> grass;
+	std::vector<SheepSnapshot> sheep;
+	std::vector<WolfSnapshot> wolves;
+	std::vector<ParticleSnapshot> particles;
+
+	Vector2 worldSize = { 0.0f, 0.0f };
+
+	float cellSize = 0.0f;
+};
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <World/MovementBounds.h>
+
+#include <raylib.h>
+
+#include <cstdint>
+#include <vector>
+
+
+class SheepStateMachine;
+
+
+// Activity a sheep is currently performing, kept in the sheep store and exposed as SheepStateMachine::SheepState.
+enum class SheepActivity : uint8_t
+{
+	WanderingAlone,
+	WanderingInGroup,
+	Eating,
+	Defecating,
+	RunningAway,
+	Reproducing
+};
+
+
+// Structure-of-arrays storage for the per-sheep fields touched every frame, so bulk passes stream through contiguous memory.
+// Slots stay dense: removing a sheep moves the last one into the gap and tells its owner about the new slot.
+class SheepStore
+{
+public:
+	static constexpr int32_t NoGroup = -1;
+
+	SheepStore() = default;
+
+	SheepStore(const SheepStore&) = delete;
+	SheepStore& operator=(const SheepStore&) = delete;
+
+	size_t Add(SheepStateMachine* owner, Vector2 position, float initialHealth);
+	void Remove(size_t slot);
+	void Integrate(float deltaTime, const MovementBounds& bounds);
+
+
+	void SetPosition(size_t slot, Vector2 position) { positionX[slot] = position.x; positionY[slot] = position.y; }
+	void SetVelocity(size_t slot, Vector2 velocity) { velocityX[slot] = velocity.x; velocityY[slot] = velocity.y; }
+	void SetActivity(size_t slot, SheepActivity value) { activity[slot] = value; }
+	void SetGroupId(size_t slot, int32_t value) { groupId[slot] = value; }
+	void SetFullness(size_t slot, float value) { fullness[slot] = value; }
+	void SetHunger(size_t slot, float value) { hunger[slot] = value; }
+	void SetHealth(size_t slot, float value) { health[slot] = value; }
+
+	Vector2 GetPosition(size_t slot) const { return { positionX[slot], positionY[slot] }; }
+	Vector2 GetPreviousPosition(size_t slot) const { return { previousPositionX[slot], previousPositionY[slot] }; }
+	SheepActivity GetActivity(size_t slot) const { return activity[slot]; }
+	int32_t GetGroupId(size_t slot) const { return groupId[slot]; }
+	float GetFullness(size_t slot) const { return fullness[slot]; }
+	float GetHunger(size_t slot) const { return hunger[slot]; }
+	float GetHealth(size_t slot) const { return health[slot]; }
+
+
+	const std::vector<SheepStateMachine*>& GetOwners() const { return owners; }
+	const std::vector<float>& GetPositionsX() const { return positionX; }
+	const std::vector<float>& GetPositionsY() const { return positionY; }
+	const std::vector<float>& GetHealths() const { return health; }
+	const std::vector<float>& GetHungers() const { return hunger; }
+
+	size_t GetCount() const { return owners.size(); }
+
+private:
+	std::vector<SheepStateMachine*> owners;
+	std::vector<SheepActivity> activity;
+	std::vector<int32_t> groupId;
+
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> health;
+	std::vector<float> hunger;
+	std::vector<float> fullness;
+
+	// Positions from before the last Integrate, so the world can tell which sheep moved.
+	std::vector<float> previousPositionX;
+	std::vector<float> previousPositionY;
+};
\ No newline at end of file
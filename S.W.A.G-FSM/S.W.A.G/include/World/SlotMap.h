@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+
+// Reference to an entity stored in a SlotMap, which stops resolving once that entity is released even if its slot is reused.
+template<typename T>
+struct EntityHandle
+{
+	static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+	uint32_t index = InvalidIndex;
+	uint32_t generation = 0;
+
+	bool IsNull() const { return index == InvalidIndex; }
+
+	bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+
+// Maps generation-checked handles to live entities, so holders of a handle can tell in constant time whether the entity still exists.
+template<typename T>
+class SlotMap
+{
+public:
+	SlotMap() = default;
+
+	SlotMap(const SlotMap&) = delete;
+	SlotMap& operator=(const SlotMap&) = delete;
+
+	EntityHandle<T> Insert(T* entity);
+	void Remove(EntityHandle<T> handle);
+	bool Retire(EntityHandle<T> handle);
+	void Recycle(uint32_t index) { freeSlots.push_back(index); }
+
+	T* Get(EntityHandle<T> handle) const;
+
+	bool IsValid(EntityHandle<T> handle) const { return Get(handle) != nullptr; }
+
+	size_t GetCount() const { return slots.size() - freeSlots.size(); }
+
+private:
+	struct Slot
+	{
+		T* entity;
+
+		uint32_t generation;
+	};
+
+
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+};
+
+
+// Stores an entity in a free slot, or a new one if none is free, and returns a handle to it.
+template<typename T>
+EntityHandle<T> SlotMap<T>::Insert(T* entity)
+{
+	uint32_t index;
+
+	if (!freeSlots.empty())
+	{
+		index = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(slots.size());
+		slots.push_back({ nullptr, 0 });
+	}
+
+	slots[index].entity = entity;
+
+	return { index, slots[index].generation };
+}
+
+// Releases the slot a handle points to, invalidating that handle and every copy of it. Stale handles are ignored.
+template<typename T>
+void SlotMap<T>::Remove(EntityHandle<T> handle)
+{
+	if (Retire(handle))
+	{
+		Recycle(handle.index);
+	}
+}
+
+// Invalidates a handle and every copy of it without freeing its slot yet, returning whether it was live. The slot must be recycled later.
+// Lets several threads release entities at once, since each only writes the slot of its own entity.
+template<typename T>
+bool SlotMap<T>::Retire(EntityHandle<T> handle)
+{
+	if (!Get(handle))
+	{
+		return false;
+	}
+
+	Slot& slot = slots[handle.index];
+	slot.entity = nullptr;
+	slot.generation++;
+
+	return true;
+}
+
+// Returns the entity a handle points to, or null if the handle is empty or its entity was released.
+template<typename T>
+T* SlotMap<T>::Get(EntityHandle<T> handle) const
+{
+	if (handle.index >= slots.size())
+	{
+		return nullptr;
+	}
+
+	const Slot& slot = slots[handle.index];
+
+	return slot.generation == handle.generation ? slot.entity : nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <Utility/ProximityKernels.h>
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <vector>
+
+
+// Uniform grid that buckets entities by position so proximity queries only visit the cells around the query point.
+// Each bucket keeps its coordinates in packed arrays, so distances are compared by the proximity kernels several at a time.
+template<typename T>
+class SpatialGrid
+{
+public:
+	SpatialGrid() = default;
+
+	void Initialize(float maxX, float maxY, float size);
+	void Clear();
+
+	void Insert(T* entity, Vector2 position);
+	void Remove(T* entity, Vector2 position);
+	void Move(T* entity, Vector2 oldPosition, Vector2 newPosition);
+
+	template<typename Visitor>
+	void QueryRadius(Vector2 center, float radius, Visitor&& visitor) const;
+
+	template<typename Visitor>
+	void QueryRect(Rectangle area, Visitor&& visitor) const;
+
+	template<typename Predicate>
+	T* FindNearest(Vector2 center, float radius, Predicate&& predicate) const;
+
+	T* FindNearest(Vector2 center, float radius) const;
+
+private:
+	struct Bucket
+	{
+		std::vector<T*> entities;
+		std::vector<float> positionsX;
+		std::vector<float> positionsY;
+	};
+
+	// Number of bucket entries masked at once, sized so the mask stays on the stack.
+	static constexpr size_t MaskChunkSize = 64;
+
+	void RemoveAt(Bucket& bucket, size_t index);
+
+	int CellX(float x) const { return std::clamp(static_cast<int>(x / bucketSize), 0, columns - 1); }
+	int CellY(float y) const { return std::clamp(static_cast<int>(y / bucketSize), 0, rows - 1); }
+	int CellIndex(Vector2 position) const { return CellY(position.y) * columns + CellX(position.x); }
+
+
+	std::vector<Bucket> cells;
+
+
+	int columns = 1;
+	int rows = 1;
+
+	float bucketSize = 1.0f;
+};
+
+
+// Sizes the grid so that it covers the area from the origin up to the given bounds.
+template<typename T>
+void SpatialGrid<T>::Initialize(float maxX, float maxY, float size)
+{
+	bucketSize = std::max(size, 1.0f);
+
+	columns = std::max(1, static_cast<int>(maxX / bucketSize) + 1);
+	rows = std::max(1, static_cast<int>(maxY / bucketSize) + 1);
+
+	cells.assign(static_cast<size_t>(columns * rows), {});
+}
+
+// Removes every entity from the grid while keeping its dimensions.
+template<typename T>
+void SpatialGrid<T>::Clear()
+{
+	for (auto& cell : cells)
+	{
+		cell.entities.clear();
+		cell.positionsX.clear();
+		cell.positionsY.clear();
+	}
+}
+
+// Adds an entity to the bucket that contains its position.
+template<typename T>
+void SpatialGrid<T>::Insert(T* entity, Vector2 position)
+{
+	Bucket& bucket = cells[CellIndex(position)];
+
+	bucket.entities.push_back(entity);
+	bucket.positionsX.push_back(position.x);
+	bucket.positionsY.push_back(position.y);
+}
+
+// Removes an entity from the bucket that contains the position it was last stored at.
+template<typename T>
+void SpatialGrid<T>::Remove(T* entity, Vector2 position)
+{
+	Bucket& bucket = cells[CellIndex(position)];
+
+	for (size_t i = 0; i < bucket.entities.size(); i++)
+	{
+		if (bucket.entities[i] == entity)
+		{
+			RemoveAt(bucket, i);
+			return;
+		}
+	}
+}
+
+// Fills the gap at the index with the last entry of the bucket.
+template<typename T>
+void SpatialGrid<T>::RemoveAt(Bucket& bucket, size_t index)
+{
+	bucket.entities[index] = bucket.entities.back();
+	bucket.positionsX[index] = bucket.positionsX.back();
+	bucket.positionsY[index] = bucket.positionsY.back();
+
+	bucket.entities.pop_back();
+	bucket.positionsX.pop_back();
+	bucket.positionsY.pop_back();
+}
+
+// Updates the stored position of an entity, moving it to a different bucket only when it crossed a cell boundary.
+template<typename T>
+void SpatialGrid<T>::Move(T* entity, Vector2 oldPosition, Vector2 newPosition)
+{
+	int oldIndex = CellIndex(oldPosition);
+	int newIndex = CellIndex(newPosition);
+
+	if (oldIndex == newIndex)
+	{
+		Bucket& bucket = cells[oldIndex];
+
+		for (size_t i = 0; i < bucket.entities.size(); i++)
+		{
+			if (bucket.entities[i] == entity)
+			{
+				bucket.positionsX[i] = newPosition.x;
+				bucket.positionsY[i] = newPosition.y;
+				return;
+			}
+		}
+	}
+
+	Remove(entity, oldPosition);
+	Insert(entity, newPosition);
+}
+
+// Calls the visitor with every entity whose stored position lies within the radius of the center.
+template<typename T>
+template<typename Visitor>
+void SpatialGrid<T>::QueryRadius(Vector2 center, float radius, Visitor&& visitor) const
+{
+	float radiusSquared = radius * radius;
+
+	int minCellX = CellX(center.x - radius);
+	int maxCellX = CellX(center.x + radius);
+	int minCellY = CellY(center.y - radius);
+	int maxCellY = CellY(center.y + radius);
+
+	for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+	{
+		for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+		{
+			const Bucket& bucket = cells[cellY * columns + cellX];
+
+			for (size_t start = 0; start < bucket.entities.size(); start += MaskChunkSize)
+			{
+				size_t chunk = std::min(MaskChunkSize, bucket.entities.size() - start);
+
+				uint8_t mask[MaskChunkSize];
+
+				if (ProximityKernels::MaskWithinRadius(bucket.positionsX.data() + start, bucket.positionsY.data() + start, chunk, center, radiusSquared, mask) == 0)
+				{
+					continue;
+				}
+
+				for (size_t i = 0; i < chunk; i++)
+				{
+					if (mask[i])
+					{
+						visitor(bucket.entities[start + i]);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Calls the visitor with every entity whose stored position lies inside the rectangle.
+template<typename T>
+template<typename Visitor>
+void SpatialGrid<T>::QueryRect(Rectangle area, Visitor&& visitor) const
+{
+	float maxX = area.x + area.width;
+	float maxY = area.y + area.height;
+
+	int minCellX = CellX(area.x);
+	int maxCellX = CellX(maxX);
+	int minCellY = CellY(area.y);
+	int maxCellY = CellY(maxY);
+
+	for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+	{
+		for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+		{
+			const Bucket& bucket = cells[cellY * columns + cellX];
+
+			for (size_t i = 0; i < bucket.entities.size(); i++)
+			{
+				float x = bucket.positionsX[i];
+				float y = bucket.positionsY[i];
+
+				if (x >= area.x && x <= maxX && y >= area.y && y <= maxY)
+				{
+					visitor(bucket.entities[i]);
+				}
+			}
+		}
+	}
+}
+
+// Returns the closest entity accepted by the predicate that is strictly within the radius, or null if there is none.
+template<typename T>
+template<typename Predicate>
+T* SpatialGrid<T>::FindNearest(Vector2 center, float radius, Predicate&& predicate) const
+{
+	T* closest = nullptr;
+
+	float closestDistanceSquared = radius * radius;
+
+	int minCellX = CellX(center.x - radius);
+	int maxCellX = CellX(center.x + radius);
+	int minCellY = CellY(center.y - radius);
+	int maxCellY = CellY(center.y + radius);
+
+	for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+	{
+		for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+		{
+			const Bucket& bucket = cells[cellY * columns + cellX];
+
+			for (size_t start = 0; start < bucket.entities.size(); start += MaskChunkSize)
+			{
+				size_t chunk = std::min(MaskChunkSize, bucket.entities.size() - start);
+
+				uint8_t mask[MaskChunkSize];
+
+				if (ProximityKernels::MaskWithinRadius(bucket.positionsX.data() + start, bucket.positionsY.data() + start, chunk, center, closestDistanceSquared, mask) == 0)
+				{
+					continue;
+				}
+
+				// Only the few entries inside the radius reach the predicate, in bucket order like before.
+				for (size_t i = 0; i < chunk; i++)
+				{
+					if (!mask[i])
+					{
+						continue;
+					}
+
+					float dx = center.x - bucket.positionsX[start + i];
+					float dy = center.y - bucket.positionsY[start + i];
+					float distanceSquared = dx * dx + dy * dy;
+
+					if (distanceSquared < closestDistanceSquared && predicate(bucket.entities[start + i]))
+					{
+						closestDistanceSquared = distanceSquared;
+						closest = bucket.entities[start + i];
+					}
+				}
+			}
+		}
+	}
+
+	return closest;
+}
+
+// Returns the closest entity strictly within the radius, or null if there is none, letting the kernel pick the nearest entry of each bucket.
+template<typename T>
+T* SpatialGrid<T>::FindNearest(Vector2 center, float radius) const
+{
+	T* closest = nullptr;
+
+	float closestDistanceSquared = radius * radius;
+
+	int minCellX = CellX(center.x - radius);
+	int maxCellX = CellX(center.x + radius);
+	int minCellY = CellY(center.y - radius);
+	int maxCellY = CellY(center.y + radius);
+
+	for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+	{
+		for (int cellX = minCellX; cellX <= maxCellX; cellX++)
+		{
+			const Bucket& bucket = cells[cellY * columns + cellX];
+
+			size_t index = ProximityKernels::FindNearest(bucket.positionsX.data(), bucket.positionsY.data(), bucket.entities.size(), center, closestDistanceSquared);
+
+			if (index != ProximityKernels::NotFound)
+			{
+				float dx = center.x - bucket.positionsX[index];
+				float dy = center.y - bucket.positionsY[index];
+
+				closestDistanceSquared = dx * dx + dy * dy;
+				closest = bucket.entities[index];
+			}
+		}
+	}
+
+	return closest;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <raylib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+
+// Coarse grid that stores, for every cell, the wolf nearest to it and the push away from the screen edges.
+// The wolf part is rebuilt once per tick by spreading each wolf outwards over the grid, so fleeing sheep look up their threat in constant time.
+class ThreatField
+{
+public:
+	struct Threat
+	{
+		Vector2 wolfPosition;
+		Vector2 edgeAvoidance;
+
+		bool hasWolf;
+	};
+
+	ThreatField() = default;
+
+	void Initialize(float maxX, float maxY, float size, Vector2 edgeBounds, float edgeMargin);
+
+	void Clear();
+	void AddWolf(Vector2 position);
+	void Propagate();
+
+	Threat Sample(Vector2 position) const;
+
+private:
+	void TakeNearerWolf(int cellX, int cellY, int neighborX, int neighborY);
+
+	int CellX(float x) const { return std::clamp(static_cast<int>(x / cellSize), 0, columns - 1); }
+	int CellY(float y) const { return std::clamp(static_cast<int>(y / cellSize), 0, rows - 1); }
+	int CellIndex(int cellX, int cellY) const { return cellY * columns + cellX; }
+
+	Vector2 CellCenter(int cellX, int cellY) const { return { (cellX + 0.5f) * cellSize, (cellY + 0.5f) * cellSize }; }
+
+
+	std::vector<Vector2> wolves;
+
+	std::vector<int32_t> nearestWolf;
+	std::vector<float> nearestDistanceSquared;
+
+	std::vector<float> edgeAvoidanceX;
+	std::vector<float> edgeAvoidanceY;
+
+
+	int columns = 1;
+	int rows = 1;
+
+	float cellSize = 1.0f;
+};
\ No newline at end of file
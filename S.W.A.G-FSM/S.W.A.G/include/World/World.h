@@ -4,12 +4,28 @@
 #include <Entities/Sheep/SheepStateMachine.h>
 #include <Entities/Wolf/WolfStateMachine.h>
 #include <Utility/SimulationConfig.h>
+#include <Utility/PhaseGraph.h>
+#include <Utility/JobSystem.h>
+#include <Utility/Random.h>
 #include <Simulation/Simulation.h>
+#include <World/DomainDecomposition.h>
+#include <World/CommandBuffer.h>
+#include <World/DenRegistry.h>
+#include <World/EntityHandles.h>
+#include <World/FlockRegistry.h>
+#include <World/MovementBounds.h>
+#include <World/ParticleSystem.h>
+#include <World/RenderSnapshot.h>
+#include <World/SpatialGrid.h>
+#include <World/SheepStore.h>
+#include <World/ThreatField.h>
 
 #include <raylib.h>
 
+#include <unordered_map>
 #include <vector>
 #include <memory>
+#include <array>
 
 
 class WolfStateMachine;
@@ -17,46 +33,40 @@ class GrassStateMachine;
 class Simulation;
 
 
-struct SheepPoopInstance
+// Fixed-capacity list of the in-bounds cells around a grid position, returned by value so neighbour lookups never touch the heap.
+struct CellNeighbors
 {
-	Vector2 position;
+	std::array<Vector2, 8> cells;
 
-	float lifetime;
+	int count = 0;
 
-	static constexpr float maxLifetime = 10.0f;
-};
-
-struct BloodSplatterInstance
-{
-	Vector2 position;
-
-	float lifetime;
-	float size;
-
-	static constexpr float maxLifetime = 5.0f;
+	const Vector2* begin() const { return cells.data(); }
+	const Vector2* end() const { return cells.data() + count; }
 };
 
 class World
 {
 public:
-	World(int width, int height, float cellSize, float viewportYOffset, float scaleFactor, Simulation* simulation);
+	World(int width, int height, float cellSize, Simulation* simulation);
 	~World() = default;
 
 	void Initialize(int grassCount = RuntimeConfig::WorldInitialGrassCount(), int sheepCount = RuntimeConfig::WorldInitialSheepCount(), int wolfCount = RuntimeConfig::WorldInitialWolfCount());
 
 	void Update(float deltaTime);
-	void Draw();
+	void WriteSnapshot(RenderSnapshot& snapshot) const;
 
-	void UpdateBloodSplatters(float deltaTime);
 	void SpreadSeeds(const Vector2& position);
 	void AddBloodSplatter(Vector2 position);
-	void UpdateSheepPoop(float deltaTime);
 	void AddSheepPoop(Vector2 position);
 	void CreateGrass(Vector2 position);
 	void CreateSheep(Vector2 position);
 	void CreateWolf(Vector2 position);
 
-	bool IsSheepPoopNearby(Vector2 position, float radius) const;
+	void ClaimHuntReservation(const SheepStateMachine* sheep, WolfStateMachine* wolf) { huntReservations[sheep] = wolf; }
+	void ReleaseHuntReservation(const SheepStateMachine* sheep, const WolfStateMachine* wolf);
+
+	bool IsSheepHuntedByOther(const SheepStateMachine* sheep, const WolfStateMachine* wolf) const;
+	bool IsSheepPoopNearby(Vector2 position) const;
 	bool IsAdjacentToGrass(Vector2 position) const;
 	bool IsCellOccupied(Vector2 position) const;
 
@@ -65,33 +75,155 @@ public:
 	const std::vector<std::unique_ptr<SheepStateMachine>>& GetSheep() const { return sheeps; }
 	const std::vector<std::unique_ptr<GrassStateMachine>>& GetGrasses() const { return grasses; }
 
-	std::vector<Vector2> GetNeighboringCells(Vector2 position) const;
+	GrassStateMachine* GetGrass(GrassHandle handle) const { return grassSlots.Get(handle); }
+	SheepStateMachine* GetSheep(SheepHandle handle) const { return sheepSlots.Get(handle); }
+	WolfStateMachine* GetWolf(WolfHandle handle) const { return wolfSlots.Get(handle); }
+
+	void ReleaseGrassHandle(GrassHandle handle);
+	void ReleaseSheepHandle(SheepHandle handle);
+	void ReleaseWolfHandle(WolfHandle handle) { wolfSlots.Remove(handle); }
+	void ReleaseFlock(int32_t flockId);
+
+	int RandomValue(int min, int max);
+
+	const SpatialGrid<SheepStateMachine>& GetSheepGrid() const { return sheepGrid; }
+	const SpatialGrid<WolfStateMachine>& GetWolfGrid() const { return wolfGrid; }
+	const SpatialGrid<GrassStateMachine>& GetEdibleGrassGrid() const { return edibleGrassGrid; }
+	const ThreatField& GetThreatField() const { return threatField; }
+	const DenRegistry& GetDens() const { return dens; }
+	const MovementBounds& GetMovementBounds() const { return movementBounds; }
+
+	CommandBuffer& GetCommandBuffer() { return commandBuffers[JobSystem::GetCurrentThreadIndex()]; }
+	FlockRegistry& GetFlockRegistry() { return flockRegistry; }
+	SheepStore& GetSheepStore() { return sheepStore; }
+	const SheepStore& GetSheepStore() const { return sheepStore; }
+
+	void UpdateSheepPosition(SheepStateMachine* sheep, Vector2 oldPosition, Vector2 newPosition) { sheepGrid.Move(sheep, oldPosition, newPosition); }
+	void UpdateWolfPosition(WolfStateMachine* wolf, Vector2 oldPosition, Vector2 newPosition) { wolfGrid.Move(wolf, oldPosition, newPosition); }
+	void SetGrassEdible(GrassStateMachine* grass, bool edible);
+
+	CellNeighbors GetNeighboringCells(Vector2 position) const;
+
+	GrassStateMachine* GetGrassAt(Vector2 position) const;
 
 	Simulation* GetSimulation() const { return simulation; }
 
+	float GetCellSize() const { return cellSize; }
 	float GetMaxY() const { return static_cast<float>(height * cellSize); }
 	float GetMaxX() const { return static_cast<float>(width * cellSize); }
-	float GetMinY() const { return minY; }
-
-	float GetScaleFactor() const { return scaleFactor; }
 
 private:
+	// Order in which entities update within a tick, which is also the order their commands are applied in.
+	enum class CommandPhase : uint32_t
+	{
+		Grass,
+		Wolves,
+		Sheep
+	};
+
+	static uint64_t CommandIssuer(CommandPhase phase, size_t index) { return (static_cast<uint64_t>(phase) << 32) | static_cast<uint64_t>(index); }
+
+	// Sheep one domain updates on a worker thread, along with the releases and random numbers that must not touch shared state until every domain is done.
+	struct DomainWork
+	{
+		std::vector<size_t> sheep;
+		std::vector<uint32_t> releasedSheepSlots;
+		std::vector<uint32_t> releasedGrassSlots;
+		std::vector<int32_t> dissolvedFlocks;
+
+		Random random;
+	};
+
+	static thread_local DomainWork* activeDomain;
+
+	template<typename T, typename Predicate>
+	static void SwapAndPopIf(std::vector<std::unique_ptr<T>>& entities, Predicate&& predicate);
+
+	void BuildUpdatePhases();
+	void UpdateGrass(float deltaTime);
+	void UpdateWolves(float deltaTime);
+	void UpdateSheep(float deltaTime);
+	void UpdateSheepAt(size_t index, float deltaTime);
+	void UpdateDomainSheep(DomainWork& work, float deltaTime);
+	void AssignSheepToDomains();
+	void RecycleDomainReleases();
+	void UpdateSheepVitals(float deltaTime);
+	void RebuildThreatField();
+	void CommitTick(float deltaTime);
+
+	void PerceiveEntities(float deltaTime);
+	void IntegrateSheepMovement(float deltaTime);
+	void IntegrateWolfMovement(float deltaTime);
+	void ApplyCommands();
+	void ApplyCommand(const DamageSheepCommand& command);
+	void ApplyCommand(const JoinGroupCommand& command);
+	void ApplyCommand(const SpawnSheepCommand& command);
+	void ApplyCommand(const SpawnParticleCommand& command);
+	void ApplyCommand(const SetReproducingCommand& command);
+	void ProcessDeaths();
+	void RemoveDeadEntities();
+
+	int GetCellIndex(Vector2 position) const;
+
+	float GetDomainHalo() const;
+
+
 	Simulation* simulation;
 
 	int width;
 	int height;
 
-	float minY = 0.0f;
 	float cellSize;
-	float scaleFactor;
+	float simulationTime = 0.0f;
+	float tickDeltaTime = 0.0f;
 
+	MovementBounds movementBounds;
 
-	std::vector<SheepPoopInstance> sheepPoopInstances;
-	std::vector<BloodSplatterInstance> bloodSplatters;
+
+	ParticleSystem poopParticles;
+	ParticleSystem bloodParticles;
 
 	std::vector<Vector2> pendingGrassPositions;
+	std::vector<Vector2> pendingSheepPositions;
+
+	std::vector<GrassStateMachine*> grassCells;
+	std::vector<float> poopContaminationExpiry;
+
+	std::unordered_map<const SheepStateMachine*, WolfStateMachine*> huntReservations;
+
+	SheepStore sheepStore;
+	FlockRegistry flockRegistry;
+
+
+	SlotMap<GrassStateMachine> grassSlots;
+	SlotMap<SheepStateMachine> sheepSlots;
+	SlotMap<WolfStateMachine> wolfSlots;
+
+
+	SpatialGrid<SheepStateMachine> sheepGrid;
+	SpatialGrid<WolfStateMachine> wolfGrid;
+	SpatialGrid<GrassStateMachine> edibleGrassGrid;
+
+	ThreatField threatField;
+	DenRegistry dens;
+
 
 	std::vector<std::unique_ptr<GrassStateMachine>> grasses;
 	std::vector<std::unique_ptr<WolfStateMachine>> wolves;
 	std::vector<std::unique_ptr<SheepStateMachine>> sheeps;
+
+	std::vector<Entity*> perceivingEntities;
+	std::vector<SheepStateMachine*> sensingSheep;
+
+	std::vector<CommandBuffer> commandBuffers;
+	std::vector<WorldCommand> mergedCommands;
+
+	DomainDecomposition domains;
+
+	std::vector<DomainWork> domainWork;
+	std::vector<size_t> boundarySheep;
+
+	PhaseGraph updatePhases;
+
+	JobSystem jobs;
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Utility/TextureCache.h>
+#include <Utility/ValueConfig.h>
+#include <World/RenderSnapshot.h>
+
+#include <raylib.h>
+
+
+// Draws render snapshots of the world. It lives on the window's thread, which owns the graphics context and so every texture.
+class WorldRenderer
+{
+public:
+	WorldRenderer();
+
+	WorldRenderer(const WorldRenderer&) = delete;
+	WorldRenderer& operator=(const WorldRenderer&) = delete;
+
+	void Draw(const RenderSnapshot& snapshot, Rectangle visibleArea, float zoom, bool showDetectionRadii);
+
+private:
+	void DrawGrass(const GrassSnapshot& grass) const;
+	void DrawSheep(const SheepSnapshot& sheep, bool showDetectionRadii) const;
+	void DrawWolf(const WolfSnapshot& wolf, bool showDetectionRadii, bool drawDetail) const;
+	void DrawWolfStatusBars(Vector2 barPosition, float staminaValue) const;
+	void DrawHuntingLine(const WolfSnapshot& wolf) const;
+	void DrawGroupLines(const RenderSnapshot& snapshot, Rectangle area) const;
+	void DrawSheepStatusBars(const RenderSnapshot& snapshot, Rectangle area) const;
+
+
+	TextureCache textureCache;
+
+	TextureHandle seedsPlantedTextures[6];
+	TextureHandle fullyGrownTexture;
+	TextureHandle wiltingTexture;
+	TextureHandle sheepTexture;
+	TextureHandle wolfTexture;
+
+
+	// Cell size of the world being drawn, taken from its snapshot.
+	float cellSize = ValueConfig::World::CellSize;
+};
\ No newline at end of file
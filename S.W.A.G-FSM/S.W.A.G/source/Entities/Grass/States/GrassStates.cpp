@@ -24,7 +24,7 @@ void SeedsPlantedState::Tick(float deltaTime)
 
 	if (growthTimer >= RuntimeConfig::GrassTimeToGrow())
 	{
-		grassStateMachine->SwitchState(std::make_unique<FullyGrownState>(grassStateMachine));
+		grassStateMachine->SwitchState<FullyGrownState>(grassStateMachine);
 	}
 }
 
@@ -44,6 +44,7 @@ void FullyGrownState::Enter()
 	spreadTimer = 0.0f;
 	lifetimeTimer = 0.0f;
 	grassStateMachine->SetCurrentState(GrassStateMachine::GrassState::FullyGrown);
+	grassStateMachine->UpdateEdibility();
 }
 
 // Manages seed spreading and lifetime progression of fully grown grass.
@@ -60,7 +61,7 @@ void FullyGrownState::Tick(float deltaTime)
 
 	if (lifetimeTimer >= RuntimeConfig::GrassLifetimeBeforeWilting())
 	{
-		grassStateMachine->SwitchState(std::make_unique<WiltingState>(grassStateMachine));
+		grassStateMachine->SwitchState<WiltingState>(grassStateMachine);
 	}
 }
 
@@ -79,6 +80,7 @@ void WiltingState::Enter()
 {
 	wiltingTimer = 0.0f;
 	grassStateMachine->SetCurrentState(GrassStateMachine::GrassState::Wilting);
+	grassStateMachine->UpdateEdibility();
 }
 
 // Tracks wilting progress and triggers grass death when ready.
@@ -5,70 +5,72 @@
 
 
 // Initializes a new sheep instance with its world reference and position
-SheepStateMachine::SheepStateMachine(World* world, Vector2 position, float scaleFactor) : Entity(world, position), StateMachine(), world(world), position(position), isAlive(true), isReproducing(false), health(RuntimeConfig::SheepMaxHealth()), hunger(0.0f), fullness(0.0f), groupTimer(0.0f), groupLeader(nullptr), nearestWolf(nullptr), newSheepPositions(nullptr), scaleFactor(scaleFactor)
+SheepStateMachine::SheepStateMachine(World* world, Vector2 position) : Entity(world, position), VariantStateMachine(), world(world), store(&world->GetSheepStore()), isAlive(true), isReproducing(false)
 {
 	moveDirection = { static_cast<float>(GetRandomValue(-100, 100)) / 100.0f, static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
 
-	sheepTexture = LoadTexture("Assets/Sheep/TestSheep.png");
-
-	float minY = world->GetMinY();
-
-	if (scaleFactor <= 0.5f && this->position.y < minY)
-	{
-		this->position.y = minY;
-	}
+	storeSlot = store->Add(this, position, RuntimeConfig::SheepMaxHealth());
 }
 
+// Exits the current state while the sheep's store slot is still its own, then gives the slot back.
 SheepStateMachine::~SheepStateMachine()
 {
-	LeaveGroup();
+	Shutdown();
 
-	UnloadTexture(sheepTexture);
+	store->Remove(storeSlot);
 }
 
 // Sets up the initial state for the sheep and its starting conditions
 void SheepStateMachine::Initialize()
 {
-	SwitchState(std::make_unique<WanderingAloneState>(this));
-	currentSheepState = SheepState::WanderingAlone;
+	SwitchState<WanderingAloneState>(this);
+	SetCurrentState(SheepState::WanderingAlone);
 }
 
-// Updates sheep's vital stats over time and checks for nearby sheep and wolves
-void SheepStateMachine::Sense(float deltaTime)
+// Looks for the nearest wolf and, when alone and safe, the closest sheep to group with, without changing anything in the world.
+void SheepStateMachine::Perceive()
 {
-	hunger = std::min(hunger + RuntimeConfig::SheepHungerIncreaseRate() * deltaTime, RuntimeConfig::SheepMaxHunger());
+	Vector2 currentPosition = GetPosition();
 
-	if (hunger >= RuntimeConfig::SheepMaxHunger())
+	const WolfStateMachine* wolf = FindNearestWolf(currentPosition);
+	perception.nearestWolf = wolf ? wolf->GetHandle() : WolfHandle{};
+	perception.closestSheep = {};
+
+	if (GetCurrentState() == SheepState::WanderingAlone && !wolf)
 	{
-		health = std::max(0.0f, health - RuntimeConfig::SheepHealthDecreaseRate() * deltaTime);
+		float groupRadius = RuntimeConfig::SheepGroupRadius();
 
-		if (health <= 0.0f)
-		{
-			health = 0.0f;
-			Die();
-		}
+		const SheepStateMachine* closestSheep = world->GetSheepGrid().FindNearest(currentPosition, groupRadius, [this](const SheepStateMachine* otherSheep) { return otherSheep != this && otherSheep->IsAlive(); });
+		perception.closestSheep = closestSheep ? closestSheep->GetHandle() : SheepHandle{};
 	}
+}
 
+// Grows the sheep's hunger and, once it is starving, drains its health. Only touches the sheep's own store slot, so sheep can do it at once on the worker threads.
+void SheepStateMachine::UpdateVitals(float deltaTime)
+{
+	float hunger = std::min(GetHunger() + RuntimeConfig::SheepHungerIncreaseRate() * deltaTime, RuntimeConfig::SheepMaxHunger());
+	store->SetHunger(storeSlot, hunger);
 
-	const auto& wolves = world->GetWolves();
-
-	nearestWolf = nullptr;
-
-	float closestDistance = RuntimeConfig::SheepWolfDetectionRadius() * scaleFactor;
+	if (hunger >= RuntimeConfig::SheepMaxHunger())
+	{
+		store->SetHealth(storeSlot, std::max(0.0f, GetHealth() - RuntimeConfig::SheepHealthDecreaseRate() * deltaTime));
+	}
+}
 
-	for (const auto& wolf : wolves)
+// Dies if the vitals update starved the sheep, then acts on the nearby sheep and wolves it perceived
+void SheepStateMachine::Sense(float deltaTime)
+{
+	if (GetHealth() <= 0.0f)
 	{
-		float dx = position.x - wolf->GetPosition().x;
-		float dy = position.y - wolf->GetPosition().y;
+		Die();
+	}
 
-		float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
+	SheepState currentSheepState = GetCurrentState();
 
-		if (distance < closestDistance)
-		{
-			closestDistance = distance;
-			nearestWolf = wolf.get();
-		}
-	}
+
+	// Sheep and wolves seen during perception may have died since, so the handles are looked up again.
+	const WolfStateMachine* wolf = world->GetWolf(perception.nearestWolf);
+	nearestWolf = wolf ? wolf->GetHandle() : WolfHandle{};
 
 	if (groupCooldownTimer > 0.0f)
 	{
@@ -79,109 +81,22 @@ void SheepStateMachine::Sense(float deltaTime)
 		}
 	}
 
-	if (currentSheepState == SheepState::WanderingAlone && !nearestWolf && groupCooldownTimer <= 0.0f)
+	if (currentSheepState == SheepState::WanderingAlone && !wolf && groupCooldownTimer <= 0.0f)
 	{
-		const auto& sheeps = world->GetSheep();
-
-		float closestSheepDistance = RuntimeConfig::SheepGroupRadius() * scaleFactor;
+		SheepStateMachine* closestSheep = world->GetSheep(perception.closestSheep);
 
-		SheepStateMachine* closestSheep = nullptr;
-
-		for (const auto& otherSheep : sheeps)
+		// Grouping changes the other sheep as well, so the world does it once every sheep had its turn.
+		if (closestSheep && closestSheep->IsAlive())
 		{
-			if (otherSheep.get() == this || !otherSheep->IsAlive())
-			{
-				continue;
-			}
-
-			float dx = position.x - otherSheep->GetPosition().x;
-			float dy = position.y - otherSheep->GetPosition().y;
-			float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
-
-			if (distance < closestSheepDistance)
-			{
-				closestSheepDistance = distance;
-				closestSheep = otherSheep.get();
-			}
-		}
-
-		if (closestSheep)
-		{
-			if (closestSheep->IsInGroup())
-			{
-				SheepStateMachine* leader = closestSheep->GetGroupLeader() ? closestSheep->GetGroupLeader() : closestSheep;
-
-				if (leader->GetGroupSize() < RuntimeConfig::SheepMaxGroupSize())
-				{
-					leader->AddToGroup(this);
-
-					SetGroupLeader(leader);
-					SwitchState(std::make_unique<WanderingInGroupState>(this));
-				}
-			}
-			else
-			{
-				AddToGroup(closestSheep);
-
-				closestSheep->SetGroupLeader(this);
-				closestSheep->SwitchState(std::make_unique<WanderingInGroupState>(closestSheep));
-
-				SwitchState(std::make_unique<WanderingInGroupState>(this));
-			}
+			world->GetCommandBuffer().JoinGroup(handle, closestSheep->GetHandle());
 		}
 	}
 
-	else if (currentSheepState == SheepState::WanderingInGroup)
+	// Stragglers are split off by the flock registry, whose changes the group state picks up on its next tick.
+	else if (currentSheepState == SheepState::WanderingInGroup && wolf)
 	{
-		if (nearestWolf)
-		{
-			LeaveGroup();
-			SwitchState(std::make_unique<RunningAwayState>(this));
-		}
-
-		if (IsGroupLeader())
-		{
-			std::vector<SheepStateMachine*> membersToRemove;
-
-			for (auto member : groupMembers)
-			{
-				float dx = position.x - member->GetPosition().x;
-				float dy = position.y - member->GetPosition().y;
-				float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
-
-				if (distance > (RuntimeConfig::SheepGroupRadius() * scaleFactor) * 1.5f)
-				{
-					membersToRemove.push_back(member);
-				}
-			}
-
-			for (auto member : membersToRemove)
-			{
-				member->SetGroupLeader(nullptr);
-
-				RemoveFromGroup(member);
-
-				member->SwitchState(std::make_unique<WanderingAloneState>(member));
-			}
-
-			if (groupMembers.empty())
-			{
-				SwitchState(std::make_unique<WanderingAloneState>(this));
-			}
-		}
-		else if (groupLeader)
-		{
-			float dx = position.x - groupLeader->GetPosition().x;
-			float dy = position.y - groupLeader->GetPosition().y;
-
-			float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
-
-			if (distance > (RuntimeConfig::SheepGroupRadius() * scaleFactor) * 1.5f || !groupLeader->IsAlive())
-			{
-				LeaveGroup();
-				SwitchState(std::make_unique<WanderingAloneState>(this));
-			}
-		}
+		LeaveGroup();
+		SwitchState<RunningAwayState>(this);
 	}
 }
 
@@ -190,356 +105,185 @@ void SheepStateMachine::Decide(float deltaTime)
 {
 	(void)deltaTime;
 
-	if (nearestWolf && currentSheepState != SheepState::RunningAway)
+	SheepState currentSheepState = GetCurrentState();
+	Vector2 currentPosition = GetPosition();
+
+	if (world->GetWolf(nearestWolf) && currentSheepState != SheepState::RunningAway)
 	{
-		SwitchState(std::make_unique<RunningAwayState>(this));
+		SwitchState<RunningAwayState>(this);
 		return;
 	}
 
 	if (currentSheepState == SheepState::WanderingAlone || currentSheepState == SheepState::WanderingInGroup)
 	{
-		if (fullness >= RuntimeConfig::SheepMaxFullness())
+		if (GetFullness() >= RuntimeConfig::SheepMaxFullness())
 		{
-			SwitchState(std::make_unique<DefecatingState>(this));
+			SwitchState<DefecatingState>(this);
 			return;
 		}
 
-		if (hunger >= RuntimeConfig::SheepMaxHunger() * ValueConfig::Sheep::SheepHungerThreshold)
+		if (GetHunger() >= RuntimeConfig::SheepMaxHunger() * ValueConfig::Sheep::SheepHungerThreshold)
 		{
-			const auto& grasses = world->GetGrasses();
-			const float grassDetectionRadius = RuntimeConfig::SheepGrassDetectionRadius() * scaleFactor;
-			float minY = world->GetMinY();
-
-			float closestDistance = grassDetectionRadius;
-			GrassStateMachine* targetGrass = nullptr;
-
-			for (const auto& grass : grasses)
-			{
-				if (grass->GetCurrentState() != GrassStateMachine::GrassState::FullyGrown || grass->IsBeingEaten())
-				{
-					continue;
-				}
-
-				Vector2 grassPosition = CoordinateUtils::GridToWorldPosition(grass->GetPosition(), world->GetScaleFactor());
-
-				float drawY = grassPosition.y + minY;
-
-				if (scaleFactor <= 0.5f && drawY < minY)
-				{
-					drawY = minY;
-				}
-				else
-				{
-					drawY = grassPosition.y + minY;
-				}
-
-				Vector2 correctedGrassPosition = { grassPosition.x, drawY };
-
-				if (world->IsSheepPoopNearby(grassPosition, ValueConfig::World::CellSize * 2 * world->GetScaleFactor()))
-				{
-					continue;
-				}
-
-				float dx = position.x - grassPosition.x;
-				float dy = position.y - grassPosition.y;
-				float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
-
-				if (distance < closestDistance)
-				{
-					closestDistance = distance;
-					targetGrass = grass.get();
-				}
-			}
+			GrassStateMachine* targetGrass = FindEdibleGrass(currentPosition);
 
 			if (targetGrass)
 			{
 				targetGrass->SetBeingEaten(true);
 
-				Vector2 newPosition = CoordinateUtils::GridToWorldPosition(targetGrass->GetPosition(), world->GetScaleFactor());
-				newPosition.y += world->GetMinY();
+				SetPosition(CoordinateUtils::GridToWorldPosition(targetGrass->GetPosition(), world->GetCellSize()));
 
-				float minimumY = world->GetMinY();
-				float _scaleFactor = world->GetScaleFactor();
-				float sheepSize = ValueConfig::World::CellSize * _scaleFactor;
-				float rightMargin = 4.0f * _scaleFactor;
-				float bottomMargin = 4.0f * _scaleFactor;
-
-				float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - sheepSize - rightMargin);
-				float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - sheepSize - bottomMargin);
-
-				newPosition.x = std::max(0.0f, std::min(newPosition.x, maxX));
-				newPosition.y = std::max(minimumY, std::min(newPosition.y, maxY));
-
-				position = newPosition;
-				SwitchState(std::make_unique<SheepEatingState>(this));
+				SwitchState<SheepEatingState>(this, targetGrass);
 				return;
 			}
 		}
 	}
 
-	if (currentSheepState == SheepState::WanderingInGroup && IsGroupLeader() && health > RuntimeConfig::SheepMaxHealth() * 0.5f && groupTimer >= ValueConfig::Sheep::ReproductionInterval)
+	if (currentSheepState == SheepState::WanderingInGroup && IsGroupLeader() && GetFlock()->readyToReproduce)
 	{
-		const auto& members = GetGroupMembers();
-
-		bool hasHealthyMembers = false;
-
-		for (auto member : members)
-		{
-			if (member->GetHealth() > RuntimeConfig::SheepMaxHealth() * 0.5f)
-			{
-				hasHealthyMembers = true;
-				break;
-			}
-		}
-
-		if (hasHealthyMembers)
-		{
-			SwitchState(std::make_unique<ReproducingState>(this));
-			return;
-		}
+		SwitchState<ReproducingState>(this);
+		return;
 	}
 }
 
 // Executes the current state's behavior each frame
 void SheepStateMachine::Act(float deltaTime)
 {
-	StateMachine::Update(deltaTime);
+	VariantStateMachine::Update(deltaTime);
 }
 
-// Renders the sheep on screen with color based on its current state
-void SheepStateMachine::Draw()
+// Returns the flock this sheep belongs to, or null if it is on its own.
+const Flock* SheepStateMachine::GetFlock() const
 {
-	if (world->GetSimulation() && static_cast<Simulation*>(world->GetSimulation())->ShouldShowDetectionRadii())
-	{
-		Vector2 centerForOutline = { position.x + cellSize * scaleFactor / 2, position.y + cellSize * scaleFactor / 2 };
+	return world->GetFlockRegistry().Get(GetGroupId());
+}
 
-		Color skyBlueOutlineColor = { 102, 191, 255, 50 };
-		Color magentaOutlineColor = { 255, 0, 255, 30 };
-		Color redOutlineColor = { 230, 41, 55, 30 };
+// Returns the leader of this sheep's group, or null if the sheep is on its own or leads the group itself.
+SheepStateMachine* SheepStateMachine::GetGroupLeader() const
+{
+	const Flock* flock = GetFlock();
 
-		DrawCircleLines(static_cast<int>(centerForOutline.x), static_cast<int>(centerForOutline.y), RuntimeConfig::SheepWolfDetectionRadius() * scaleFactor, skyBlueOutlineColor);
-		DrawCircleLines(static_cast<int>(centerForOutline.x), static_cast<int>(centerForOutline.y), RuntimeConfig::SheepGrassDetectionRadius() * scaleFactor, magentaOutlineColor);
-		DrawCircleLines(static_cast<int>(centerForOutline.x), static_cast<int>(centerForOutline.y), RuntimeConfig::SheepGroupRadius() * scaleFactor, redOutlineColor);
+	if (!flock || flock->GetLeader() == handle)
+	{
+		return nullptr;
 	}
 
-	float scaledCellSize = cellSize * scaleFactor;
-	float halfSize = scaledCellSize / 2;
-	float minY = world->GetMinY();
-
-	Vector2 drawPosition = position;
+	return world->GetSheep(flock->GetLeader());
+}
 
-	if (scaleFactor <= 0.5f && drawPosition.y < minY)
+// Marks the sheep as dead and invalidates every handle other entities hold to it.
+void SheepStateMachine::Die()
+{
+	if (!isAlive)
 	{
-		drawPosition.y = minY;
+		return;
 	}
 
-	Vector2 center = { drawPosition.x + halfSize, drawPosition.y + halfSize };
-
-	Rectangle sourceRec = { 0.0f, 0.0f, static_cast<float>(sheepTexture.width), static_cast<float>(sheepTexture.height) };
-	Rectangle destRec = { drawPosition.x, drawPosition.y, scaledCellSize, scaledCellSize };
-	Vector2 origin = { 0.0f, 0.0f };
-
-	DrawTexturePro(sheepTexture, sourceRec, destRec, origin, 0.0f, WHITE);
+	isAlive = false;
 
-	float triangleOffset = 5.0f * scaleFactor;
-	float triangleScale = 0.3f;
-	float smallHalfSize = halfSize * triangleScale;
-
-	Vector2 triangleCenter = { center.x, position.y + scaledCellSize + triangleOffset };
+	world->ReleaseSheepHandle(handle);
+}
 
-	Vector2 point1 = { triangleCenter.x + smallHalfSize, triangleCenter.y };
-	Vector2 point2 = { triangleCenter.x - smallHalfSize, triangleCenter.y - smallHalfSize };
-	Vector2 point3 = { triangleCenter.x - smallHalfSize, triangleCenter.y + smallHalfSize };
+// Returns the closest wolf within detection range, read from the flock's shared perception when it has a usable one.
+const WolfStateMachine* SheepStateMachine::FindNearestWolf(Vector2 center) const
+{
+	float detectionRadius = RuntimeConfig::SheepWolfDetectionRadius();
 
-	Color sheepColor;
+	const Flock* flock = GetFlock();
 
-	if (currentSheepState == SheepState::WanderingInGroup)//|| (currentSheepState == SheepState::Eating && IsInGroup()))
-	{
-		sheepColor = { 25, 25, 153, 255 };
-	}
-	else if (currentSheepState == SheepState::RunningAway)
+	if (!flock || !flock->perception.valid)
 	{
-		sheepColor = { 255, 0, 51, 255 };
-	}
-	else if (currentSheepState == SheepState::Defecating)
-	{
-		sheepColor = { 255, 128, 0, 255 };
-	}
-	else if (currentSheepState == SheepState::Eating)
-	{
-		sheepColor = { 102, 51, 153, 255 };
-	}
-	else if (currentSheepState == SheepState::Reproducing && isReproducing)
-	{
-		sheepColor = PINK;
-	}
-	else
-	{
-		sheepColor = { 135, 206, 250, 255 };
+		return world->GetWolfGrid().FindNearest(center, detectionRadius);
 	}
 
-	DrawTriangle(point1, point2, point3, sheepColor);
+	const WolfStateMachine* closestWolf = nullptr;
 
-	DrawStatusBars(center, health, hunger);
+	float closestDistanceSquared = detectionRadius * detectionRadius;
 
-
-	if (currentSheepState == SheepState::WanderingInGroup || currentSheepState == SheepState::Reproducing || (currentSheepState == SheepState::Eating && IsInGroup()) || (currentSheepState == SheepState::Defecating && IsInGroup()))
+	for (int i = 0; i < flock->perception.wolfCount; i++)
 	{
-		if (IsGroupLeader())
+		const WolfStateMachine* wolf = world->GetWolf(flock->perception.wolves[i]);
+
+		if (!wolf)
 		{
-			for (auto member : groupMembers)
-			{
-				Vector2 memberCenter = { member->GetPosition().x + halfSize, member->GetPosition().y + halfSize };
-
-				Color lineColor;
-
-				if (currentSheepState == SheepState::Reproducing && member->GetCurrentState() == SheepState::Reproducing)
-				{
-					lineColor = PINK;
-				}
-				else if (currentSheepState == SheepState::Reproducing || member->GetCurrentState() == SheepState::Reproducing)
-				{
-					lineColor = { 220, 120, 220, 255 };
-				}
-				else if (currentSheepState == SheepState::Eating || member->GetCurrentState() == SheepState::Eating)
-				{
-					lineColor = { 102, 51, 153, 255 };
-				}
-				else if (currentSheepState == SheepState::Defecating || member->GetCurrentState() == SheepState::Defecating)
-				{
-					lineColor = { 255, 128, 0, 255 };
-				}
-				else
-				{
-					lineColor = { 25, 25, 153, 255 };
-				}
-
-				DrawLine(static_cast<int>(center.x), static_cast<int>(center.y), static_cast<int>(memberCenter.x), static_cast<int>(memberCenter.y), lineColor);
-			}
+			continue;
 		}
-		else if (groupLeader)
-		{
-			Vector2 leaderCenter = { groupLeader->GetPosition().x + halfSize, groupLeader->GetPosition().y + halfSize };
 
-			Color lineColor;
-
-			if (currentSheepState == SheepState::Reproducing && groupLeader->GetCurrentState() == SheepState::Reproducing)
-			{
-				lineColor = PINK;
-			}
-			else if (currentSheepState == SheepState::Reproducing || groupLeader->GetCurrentState() == SheepState::Reproducing)
-			{
-				lineColor = { 220, 120, 220, 255 };
-			}
-			else if (currentSheepState == SheepState::Eating || groupLeader->GetCurrentState() == SheepState::Eating)
-			{
-				lineColor = GREEN;
-			}
-			else if (currentSheepState == SheepState::Defecating || groupLeader->GetCurrentState() == SheepState::Defecating)
-			{
-				lineColor = ORANGE;
-			}
-			else
-			{
-				lineColor = BLUE;
-			}
+		float dx = center.x - wolf->GetPosition().x;
+		float dy = center.y - wolf->GetPosition().y;
+		float distanceSquared = dx * dx + dy * dy;
 
-			DrawLine(static_cast<int>(center.x), static_cast<int>(center.y), static_cast<int>(leaderCenter.x), static_cast<int>(leaderCenter.y), lineColor);
+		if (distanceSquared < closestDistanceSquared)
+		{
+			closestDistanceSquared = distanceSquared;
+			closestWolf = wolf;
 		}
 	}
+
+	return closestWolf;
 }
 
-// Draws status bar for sheep's health and hunger.
-void SheepStateMachine::DrawStatusBars(Vector2 barPosition, float healthValue, float hungerValue)
+// Returns the closest uncontaminated edible grass within detection range, read from the flock's shared perception when it has a usable one.
+GrassStateMachine* SheepStateMachine::FindEdibleGrass(Vector2 center) const
 {
-	const float barWidth = 30.0f * scaleFactor;
-	const float barHeight = 4.0f * scaleFactor;
-	const float barSpacing = 2.0f * scaleFactor;
-	const float barY = barPosition.y - cellSize * scaleFactor / 2 - 10.0f * scaleFactor;
-
+	float detectionRadius = RuntimeConfig::SheepGrassDetectionRadius();
 
-	DrawRectangle(static_cast<int>(barPosition.x - barWidth / 2), static_cast<int>(barY), static_cast<int>(barWidth), static_cast<int>(barHeight), GRAY);
+	const Flock* flock = GetFlock();
 
-	float healthPercentage = healthValue / RuntimeConfig::SheepMaxHealth();
-
-	DrawRectangle(static_cast<int>(barPosition.x - barWidth / 2), static_cast<int>(barY), static_cast<int>(barWidth * healthPercentage), static_cast<int>(barHeight), RED);
+	if (!flock || !flock->perception.valid)
+	{
+		return world->GetEdibleGrassGrid().FindNearest(center, detectionRadius, [this](const GrassStateMachine* grass)
+		{
+			Vector2 grassPosition = CoordinateUtils::GridToWorldPosition(grass->GetPosition(), world->GetCellSize());
 
-	DrawRectangle(static_cast<int>(barPosition.x - barWidth / 2), static_cast<int>(barY + barHeight + barSpacing), static_cast<int>(barWidth), static_cast<int>(barHeight), GRAY);
+			return !world->IsSheepPoopNearby(grassPosition);
+		});
+	}
 
-	float hungerPercentage = hungerValue / RuntimeConfig::SheepMaxHunger();
+	GrassStateMachine* closestGrass = nullptr;
 
-	DrawRectangle(static_cast<int>(barPosition.x - barWidth / 2), static_cast<int>(barY + barHeight + barSpacing), static_cast<int>(barWidth * (1.0f - hungerPercentage)), static_cast<int>(barHeight), GREEN);
-}
+	float closestDistanceSquared = detectionRadius * detectionRadius;
 
-// Adds sheep to a potential group if it's not full and the sheep is not the same as the current one.
-void SheepStateMachine::AddToGroup(SheepStateMachine* sheep)
-{
-	if (groupMembers.size() < RuntimeConfig::SheepMaxGroupSize() && sheep != this)
+	// A flock mate may have claimed grass since the pass, so edibility is checked again here.
+	for (int i = 0; i < flock->perception.grassCount; i++)
 	{
-		groupMembers.insert(sheep);
-	}
-}
+		GrassStateMachine* grass = world->GetGrass(flock->perception.grass[i]);
 
-// Removes sheep from the group.
-void SheepStateMachine::RemoveFromGroup(SheepStateMachine* sheep)
-{
-	groupMembers.erase(sheep);
-}
+		if (!grass || !grass->IsEdible())
+		{
+			continue;
+		}
 
-// Leaves the current group and sets the group leader to null.
-void SheepStateMachine::LeaveGroup()
-{
-	if (groupLeader && groupLeader != this)
-	{
-		groupLeader->RemoveFromGroup(this);
-	}
+		float dx = center.x - flock->perception.grassPositions[i].x;
+		float dy = center.y - flock->perception.grassPositions[i].y;
+		float distanceSquared = dx * dx + dy * dy;
 
-	for (auto member : groupMembers)
-	{
-		if (member->GetGroupLeader() == this)
+		if (distanceSquared < closestDistanceSquared)
 		{
-			member->SetGroupLeader(nullptr);
-			member->SwitchState(std::make_unique<WanderingAloneState>(member));
+			closestDistanceSquared = distanceSquared;
+			closestGrass = grass;
 		}
 	}
 
-	groupMembers.clear();
-	groupLeader = nullptr;
+	return closestGrass;
+}
+
+// Leaves the current group. The remaining members stay together and notice the change on their own.
+void SheepStateMachine::LeaveGroup()
+{
+	world->GetFlockRegistry().Leave(this);
 }
 
 // Reuests new sheep to be added after reproduction state has happened.
 void SheepStateMachine::RequestNewSheep(Vector2 newPosition)
 {
-	if (newSheepPositions)
-	{
-		newSheepPositions->push_back(newPosition);
-	}
+	world->GetCommandBuffer().SpawnSheep(newPosition);
 }
 
-// Sets the new position for the sheep, ensuring it stays within the world bounds.
+// Places the sheep at a position straight away, clamped to the world's movement bounds. Ordinary movement goes through SetDesiredVelocity.
 void SheepStateMachine::SetPosition(Vector2 newPosition)
 {
-	float minY = world->GetMinY();
-	float sheepSize = ValueConfig::World::CellSize * scaleFactor;
-	float rightMargin = 4.0f * scaleFactor;
-	float bottomMargin = 4.0f * scaleFactor;
-
-	float topOffset = 0.0f;
-
-	if (scaleFactor <= 0.5f)
-	{
-		topOffset = 15.0f * scaleFactor;
-	}
-	else if (scaleFactor >= 0.5f && scaleFactor <= 0.75f)
-	{
-		topOffset = 10.0f * scaleFactor;
-	}
-
-	float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - sheepSize - rightMargin);
-	float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - sheepSize - bottomMargin);
-
-	newPosition.x = std::max(0.0f, std::min(newPosition.x, maxX));
-	newPosition.y = std::max(minY + topOffset, std::min(newPosition.y, maxY));
+	newPosition = world->GetMovementBounds().Clamp(newPosition);
 
-	position = newPosition;
+	world->UpdateSheepPosition(this, GetPosition(), newPosition);
+	store->SetPosition(storeSlot, newPosition);
 }
\ No newline at end of file
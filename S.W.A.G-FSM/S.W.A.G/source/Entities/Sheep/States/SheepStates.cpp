@@ -21,7 +21,7 @@ void WanderingAloneState::Enter()
 	}
 
 	sheepStateMachine->SetCurrentState(SheepStateMachine::SheepState::WanderingAlone);
-	moveDirection = { static_cast<float>(GetRandomValue(-100, 100)) / 100.0f,static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
+	moveDirection = { static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f,static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f };
 }
 
 // Updates sheep position and manages random movement patterns.
@@ -31,36 +31,11 @@ void WanderingAloneState::Tick(float deltaTime)
 
 	if (movementTimer >= timeToChangeDirection)
 	{
-		moveDirection = { static_cast<float>(GetRandomValue(-100, 100)) / 100.0f,static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
+		moveDirection = { static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f,static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f };
 		movementTimer = 0.0f;
 	}
 
-	Vector2 currentPosition = sheepStateMachine->GetPosition();
-	float scaleFactor = sheepStateMachine->GetWorld()->GetScaleFactor();
-	float scaledSpeed = moveSpeed * scaleFactor;
-
-	currentPosition.x += moveDirection.x * scaledSpeed * deltaTime;
-	currentPosition.y += moveDirection.y * scaledSpeed * deltaTime;
-
-	World* world = sheepStateMachine->GetWorld();
-	float minimumY = world->GetMinY();
-
-	if (scaleFactor <= 0.5f && currentPosition.y < minimumY)
-	{
-		currentPosition.y = minimumY;
-	}
-
-	float sheepSize = ValueConfig::World::CellSize * scaleFactor;
-	float rightMargin = 4.0f * scaleFactor;
-	float bottomMargin = 4.0f * scaleFactor;
-
-	float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - sheepSize - rightMargin);
-	float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - sheepSize - bottomMargin);
-
-	currentPosition.x = std::max(0.0f, std::min(currentPosition.x, maxX));
-	currentPosition.y = std::max(minimumY, std::min(currentPosition.y, maxY));
-
-	sheepStateMachine->SetPosition(currentPosition);
+	sheepStateMachine->SetDesiredVelocity({ moveDirection.x * moveSpeed, moveDirection.y * moveSpeed });
 }
 
 // Cleanup when exiting wandering alone state.
@@ -84,33 +59,28 @@ void WanderingInGroupState::Enter()
 
 	sheepStateMachine->SetCurrentState(SheepStateMachine::SheepState::WanderingInGroup);
 
-	moveDirection = { static_cast<float>(GetRandomValue(-100, 100)) / 100.0f, static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
+	moveDirection = { static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f, static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f };
 }
 
 // Manages cohesive movement behavior for grouped sheep.
 void WanderingInGroupState::Tick(float deltaTime)
 {
 	movementTimer += deltaTime;
-	sheepStateMachine->UpdateGroupTimer(deltaTime);
 
-	float scaleFactor = sheepStateMachine->GetWorld()->GetScaleFactor();
-	float scaledSpeed = moveSpeed * scaleFactor;
-	float scaledMinGroupDistance = ValueConfig::Sheep::MinGroupDistance * scaleFactor;
-	float scaledMaxGroupDistance = ValueConfig::Sheep::MaxGroupDistance * scaleFactor;
-	float minimumY = sheepStateMachine->GetWorld()->GetMinY();
+	const Flock* flock = sheepStateMachine->GetFlock();
 
-	if (sheepStateMachine->GetGroupTimer() >= ValueConfig::Sheep::ReproductionInterval && sheepStateMachine->IsGroupLeader() && sheepStateMachine->GetHealth() > RuntimeConfig::SheepMaxHealth() * 0.5f)
+	if (sheepStateMachine->IsGroupLeader() && flock->readyToReproduce)
 	{
-		sheepStateMachine->ResetGroupTimer();
-
-		const auto& members = sheepStateMachine->GetGroupMembers();
+		sheepStateMachine->GetWorld()->GetFlockRegistry().ResetReproductionTimer(sheepStateMachine->GetGroupId());
 
 		std::vector<SheepStateMachine*> candidateSheep;
 		candidateSheep.push_back(sheepStateMachine);
 
-		for (auto member : members)
+		for (SheepHandle memberHandle : *flock)
 		{
-			if (member->GetHealth() > RuntimeConfig::SheepMaxHealth() * 0.5f)
+			SheepStateMachine* member = sheepStateMachine->GetWorld()->GetSheep(memberHandle);
+
+			if (member && member != sheepStateMachine && member->GetHealth() > RuntimeConfig::SheepMaxHealth() * 0.5f)
 			{
 				candidateSheep.push_back(member);
 			}
@@ -118,7 +88,7 @@ void WanderingInGroupState::Tick(float deltaTime)
 
 		for (int i = 0; i < static_cast<int>(candidateSheep.size()); i++)
 		{
-			int j = GetRandomValue(0, static_cast<int>(candidateSheep.size()) - 1);
+			int j = sheepStateMachine->GetWorld()->RandomValue(0, static_cast<int>(candidateSheep.size()) - 1);
 
 			if (i != j)
 			{
@@ -128,15 +98,15 @@ void WanderingInGroupState::Tick(float deltaTime)
 
 		int pairCount = static_cast<int>(candidateSheep.size()) / 2;
 
+		CommandBuffer& commands = sheepStateMachine->GetWorld()->GetCommandBuffer();
+
 		for (int i = 0; i < pairCount; i++)
 		{
-			candidateSheep[i * 2]->SetIsReproducing(true);
-			candidateSheep[i * 2]->SetCurrentState(SheepStateMachine::SheepState::Reproducing);
+			commands.SetReproducing(candidateSheep[i * 2]->GetHandle(), true);
 
 			if (i * 2 + 1 < static_cast<int>(candidateSheep.size()))
 			{
-				candidateSheep[i * 2 + 1]->SetIsReproducing(true);
-				candidateSheep[i * 2 + 1]->SetCurrentState(SheepStateMachine::SheepState::Reproducing);
+				commands.SetReproducing(candidateSheep[i * 2 + 1]->GetHandle(), true);
 			}
 		}
 
@@ -145,7 +115,7 @@ void WanderingInGroupState::Tick(float deltaTime)
 			sheepStateMachine->SetIsReproducing(true);
 		}
 
-		sheepStateMachine->SwitchState(std::make_unique<ReproducingState>(sheepStateMachine));
+		sheepStateMachine->SwitchState<ReproducingState>(sheepStateMachine);
 		return;
 	}
 
@@ -153,37 +123,17 @@ void WanderingInGroupState::Tick(float deltaTime)
 	{
 		if (movementTimer >= timeToChangeDirection)
 		{
-			moveDirection = { static_cast<float>(GetRandomValue(-100, 100)) / 100.0f, static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
+			moveDirection = { static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f, static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f };
 			movementTimer = 0.0f;
 		}
 
-		Vector2 currentPosition = sheepStateMachine->GetPosition();
-
-		currentPosition.x += moveDirection.x * scaledSpeed * deltaTime;
-		currentPosition.y += moveDirection.y * scaledSpeed * deltaTime;
-
-		if (scaleFactor <= 0.5f && currentPosition.y < minimumY)
-		{
-			currentPosition.y = minimumY;
-		}
-
-		float sheepSize = ValueConfig::World::CellSize * scaleFactor;
-		float rightMargin = 4.0f * scaleFactor;
-		float bottomMargin = 4.0f * scaleFactor;
-
-		float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - sheepSize - rightMargin);
-		float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - sheepSize - bottomMargin);
-
-		currentPosition.x = std::max(0.0f, std::min(currentPosition.x, maxX));
-		currentPosition.y = std::max(minimumY, std::min(currentPosition.y, maxY));
-
-		sheepStateMachine->SetPosition(currentPosition);
+		sheepStateMachine->SetDesiredVelocity({ moveDirection.x * moveSpeed, moveDirection.y * moveSpeed });
 	}
 	else if (SheepStateMachine* leader = sheepStateMachine->GetGroupLeader())
 	{
 		if (movementTimer >= timeToChangeDirection * 0.7f)
 		{
-			moveDirection = { static_cast<float>(GetRandomValue(-100, 100)) / 100.0f, static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
+			moveDirection = { static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f, static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f };
 			movementTimer = 0.0f;
 		}
 
@@ -194,7 +144,9 @@ void WanderingInGroupState::Tick(float deltaTime)
 		float dy = leaderPosition.y - currentPosition.y;
 		float distanceToLeader = static_cast<float>(sqrt(dx * dx + dy * dy));
 
-		if (distanceToLeader > scaledMaxGroupDistance)
+		Vector2 velocity = { 0, 0 };
+
+		if (distanceToLeader > ValueConfig::Sheep::MaxGroupDistance)
 		{
 			Vector2 toLeaderDirection = { 0, 0 };
 
@@ -214,10 +166,10 @@ void WanderingInGroupState::Tick(float deltaTime)
 				combinedDirection.y /= combinedLength;
 			}
 
-			currentPosition.x += combinedDirection.x * scaledSpeed * deltaTime;
-			currentPosition.y += combinedDirection.y * scaledSpeed * deltaTime;
+			velocity.x = combinedDirection.x * moveSpeed;
+			velocity.y = combinedDirection.y * moveSpeed;
 		}
-		else if (distanceToLeader < scaledMinGroupDistance)
+		else if (distanceToLeader < ValueConfig::Sheep::MinGroupDistance)
 		{
 			Vector2 awayFromLeaderDirection = { 0, 0 };
 
@@ -227,66 +179,25 @@ void WanderingInGroupState::Tick(float deltaTime)
 				awayFromLeaderDirection.y = -dy / distanceToLeader;
 			}
 
-			currentPosition.x += awayFromLeaderDirection.x * scaledSpeed * 0.5f * deltaTime;
-			currentPosition.y += awayFromLeaderDirection.y * scaledSpeed * 0.5f * deltaTime;
+			velocity.x = awayFromLeaderDirection.x * moveSpeed * 0.5f;
+			velocity.y = awayFromLeaderDirection.y * moveSpeed * 0.5f;
 		}
 		else
 		{
-			currentPosition.x += moveDirection.x * scaledSpeed * 0.8f * deltaTime;
-			currentPosition.y += moveDirection.y * scaledSpeed * 0.8f * deltaTime;
-		}
-
-		const auto& groupMembers = leader->GetGroupMembers();
-
-		for (auto member : groupMembers)
-		{
-			if (member == sheepStateMachine)
-			{
-				continue;
-			}
-
-			Vector2 memberPosition = member->GetPosition();
-
-			float memberDx = currentPosition.x - memberPosition.x;
-			float memberDy = currentPosition.y - memberPosition.y;
-			float memberDistance = static_cast<float>(sqrt(memberDx * memberDx + memberDy * memberDy));
-
-			if (memberDistance < scaledMinGroupDistance)
-			{
-				Vector2 awayFromMemberDirection = { 0, 0 };
-
-				if (memberDistance > 0)
-				{
-					awayFromMemberDirection.x = memberDx / memberDistance;
-					awayFromMemberDirection.y = memberDy / memberDistance;
-				}
-
-				currentPosition.x += awayFromMemberDirection.x * scaledSpeed * 0.5f * deltaTime;
-				currentPosition.y += awayFromMemberDirection.y * scaledSpeed * 0.5f * deltaTime;
-			}
-		}
-
-
-		if (scaleFactor <= 0.5f && currentPosition.y < minimumY)
-		{
-			currentPosition.y = minimumY;
+			velocity.x = moveDirection.x * moveSpeed * 0.8f;
+			velocity.y = moveDirection.y * moveSpeed * 0.8f;
 		}
 
-		float sheepSize = ValueConfig::World::CellSize * scaleFactor;
-		float rightMargin = 4.0f * scaleFactor;
-		float bottomMargin = 4.0f * scaleFactor;
+		Vector2 separation = flock->GetSeparation(sheepStateMachine->GetHandle());
 
-		float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - sheepSize - rightMargin);
-		float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - sheepSize - bottomMargin);
+		velocity.x += separation.x * moveSpeed * 0.5f;
+		velocity.y += separation.y * moveSpeed * 0.5f;
 
-		currentPosition.x = std::max(0.0f, std::min(currentPosition.x, maxX));
-		currentPosition.y = std::max(minimumY, std::min(currentPosition.y, maxY));
-
-		sheepStateMachine->SetPosition(currentPosition);
+		sheepStateMachine->SetDesiredVelocity(velocity);
 	}
 	else
 	{
-		sheepStateMachine->SwitchState(std::make_unique<WanderingAloneState>(sheepStateMachine));
+		sheepStateMachine->SwitchState<WanderingAloneState>(sheepStateMachine);
 	}
 }
 
@@ -295,8 +206,8 @@ void WanderingInGroupState::Exit()
 {
 }
 
-// Initializes the eating state with a zero consumption timer.
-SheepEatingState::SheepEatingState(SheepStateMachine* stateMachine) : SheepBaseState(stateMachine), eatingTimer(0.0f), targetGrass(nullptr)
+// Initializes the eating state with a zero consumption timer and the grass the sheep reserved.
+SheepEatingState::SheepEatingState(SheepStateMachine* stateMachine, GrassStateMachine* targetGrass) : SheepBaseState(stateMachine), eatingTimer(0.0f), targetGrass(targetGrass ? targetGrass->GetHandle() : GrassHandle{})
 {
 }
 
@@ -310,41 +221,6 @@ void SheepEatingState::Enter()
 
 	sheepStateMachine->SetCurrentState(SheepStateMachine::SheepState::Eating);
 	eatingTimer = 0.0f;
-
-	const auto& grasses = sheepStateMachine->GetWorld()->GetGrasses();
-	const Vector2& sheepPosition = sheepStateMachine->GetPosition();
-
-	float scaleFactor = sheepStateMachine->GetWorld()->GetScaleFactor();
-	float scaledCellSize = ValueConfig::World::CellSize * scaleFactor;
-	float minY = sheepStateMachine->GetWorld()->GetMinY();
-
-	for (const auto& grass : grasses)
-	{
-		Vector2 grassPosition = CoordinateUtils::GridToWorldPosition(grass->GetPosition(), scaleFactor);
-
-		float drawY = grassPosition.y + minY;
-
-		if (scaleFactor <= 0.5f && drawY < minY)
-		{
-			drawY = minY;
-		}
-		else
-		{
-			drawY = grassPosition.y + minY;
-		}
-
-		Vector2 correctedGrassPosition = { grassPosition.x, drawY };
-
-		float dx = sheepPosition.x - correctedGrassPosition.x;
-		float dy = sheepPosition.y - correctedGrassPosition.y;
-		float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
-
-		if (distance < scaledCellSize / 2)
-		{
-			targetGrass = grass.get();
-			break;
-		}
-	}
 }
 
 // Manages grass consumption and hunger/fullness updates.
@@ -356,46 +232,33 @@ void SheepEatingState::Tick(float deltaTime)
 	{
 		bool foundGrass = false;
 
-		float scaleFactor = sheepStateMachine->GetWorld()->GetScaleFactor();
-		float scaledCellSize = ValueConfig::World::CellSize * scaleFactor;
-		float minY = sheepStateMachine->GetWorld()->GetMinY();
+		float cellSize = sheepStateMachine->GetWorld()->GetCellSize();
+
+		GrassStateMachine* grass = sheepStateMachine->GetWorld()->GetGrass(targetGrass);
 
-		if (targetGrass && targetGrass->IsAlive() && targetGrass->GetCurrentState() == GrassStateMachine::GrassState::FullyGrown)
+		if (grass && grass->GetCurrentState() == GrassStateMachine::GrassState::FullyGrown)
 		{
-			targetGrass->Die();
+			grass->Die();
 			foundGrass = true;
 		}
 		else
 		{
-			const auto& grasses = sheepStateMachine->GetWorld()->GetGrasses();
 			const Vector2& sheepPosition = sheepStateMachine->GetPosition();
 
-			for (const auto& grass : grasses)
-			{
-				Vector2 grassPosition = CoordinateUtils::GridToWorldPosition(grass->GetPosition(), scaleFactor);
-
-				float drawY = grassPosition.y + minY;
+			Vector2 sheepCell = { roundf(sheepPosition.x / cellSize), roundf(sheepPosition.y / cellSize) };
 
-				if (scaleFactor <= 0.5f && drawY < minY)
-				{
-					drawY = minY;
-				}
-				else
-				{
-					drawY = grassPosition.y + minY;
-				}
-
-				Vector2 correctedGrassPosition = { grassPosition.x, drawY };
+			if (GrassStateMachine* cellGrass = sheepStateMachine->GetWorld()->GetGrassAt(sheepCell))
+			{
+				Vector2 grassPosition = CoordinateUtils::GridToWorldPosition(cellGrass->GetPosition(), cellSize);
 
-				float dx = sheepPosition.x - correctedGrassPosition.x;
-				float dy = sheepPosition.y - correctedGrassPosition.y;
+				float dx = sheepPosition.x - grassPosition.x;
+				float dy = sheepPosition.y - grassPosition.y;
 				float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
 
-				if (distance < scaledCellSize / 2)
+				if (distance < cellSize / 2)
 				{
-					grass->Die();
+					cellGrass->Die();
 					foundGrass = true;
-					break;
 				}
 			}
 		}
@@ -408,11 +271,11 @@ void SheepEatingState::Tick(float deltaTime)
 
 		if (sheepStateMachine->IsInGroup())
 		{
-			sheepStateMachine->SwitchState(std::make_unique<WanderingInGroupState>(sheepStateMachine));
+			sheepStateMachine->SwitchState<WanderingInGroupState>(sheepStateMachine);
 		}
 		else
 		{
-			sheepStateMachine->SwitchState(std::make_unique<WanderingAloneState>(sheepStateMachine));
+			sheepStateMachine->SwitchState<WanderingAloneState>(sheepStateMachine);
 		}
 	}
 }
@@ -420,11 +283,12 @@ void SheepEatingState::Tick(float deltaTime)
 // Cleanup when exiting eating state.
 void SheepEatingState::Exit()
 {
-	if (targetGrass)
+	if (GrassStateMachine* grass = sheepStateMachine->GetWorld()->GetGrass(targetGrass))
 	{
-		targetGrass->SetBeingEaten(false);
-		targetGrass = nullptr;
+		grass->SetBeingEaten(false);
 	}
+
+	targetGrass = GrassHandle{};
 }
 
 // Initializes the defecating state with a zero defecation timer.
@@ -451,17 +315,17 @@ void DefecatingState::Tick(float deltaTime)
 
 	if (defecatingTimer >= timeToDefecate)
 	{
-		sheepStateMachine->GetWorld()->AddSheepPoop(sheepStateMachine->GetPosition());
+		sheepStateMachine->GetWorld()->GetCommandBuffer().SpawnParticle(ParticleKind::Poop, sheepStateMachine->GetPosition());
 
 		sheepStateMachine->SetFullness(0.0f);
 
 		if (sheepStateMachine->IsInGroup())
 		{
-			sheepStateMachine->SwitchState(std::make_unique<WanderingInGroupState>(sheepStateMachine));
+			sheepStateMachine->SwitchState<WanderingInGroupState>(sheepStateMachine);
 		}
 		else
 		{
-			sheepStateMachine->SwitchState(std::make_unique<WanderingAloneState>(sheepStateMachine));
+			sheepStateMachine->SwitchState<WanderingAloneState>(sheepStateMachine);
 		}
 	}
 }
@@ -484,34 +348,9 @@ void RunningAwayState::Enter()
 		printf("Sheep entered RUNNING AWAY state\n");
 	}
 
-	float scaleFactor = sheepStateMachine->GetWorld()->GetScaleFactor();
-	float scaledCellSize = ValueConfig::World::CellSize * scaleFactor;
-
-	if (sheepStateMachine->GetCurrentState() == SheepStateMachine::SheepState::Eating)
-	{
-		const auto& grasses = sheepStateMachine->GetWorld()->GetGrasses();
-
-		const Vector2& sheepPosition = sheepStateMachine->GetPosition();
-
-		for (const auto& grass : grasses)
-		{
-			Vector2 grassPosition = CoordinateUtils::GridToWorldPosition(grass->GetPosition(), sheepStateMachine->GetWorld()->GetScaleFactor());
-
-			float dx = sheepPosition.x - grassPosition.x;
-			float dy = sheepPosition.y - grassPosition.y;
-			float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
-
-			if (distance < scaledCellSize / 2)
-			{
-				grass->SetBeingEaten(false);
-				break;
-			}
-		}
-	}
-
 	sheepStateMachine->SetCurrentState(SheepStateMachine::SheepState::RunningAway);
 
-	randomDirectionOffset = { static_cast<float>(GetRandomValue(-100, 100)) / 100.0f,static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
+	randomDirectionOffset = { static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f,static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f };
 
 	escapeDirectionTimer = 0.0f;
 }
@@ -521,53 +360,32 @@ void RunningAwayState::Tick(float deltaTime)
 {
 	escapeDirectionTimer += deltaTime;
 
-	float scaleFactor = sheepStateMachine->GetWorld()->GetScaleFactor();
-	float scaledFleeSpeed = fleeSpeed * scaleFactor;
-	float scaledPanicDistance = ValueConfig::Sheep::PanicDistance * scaleFactor;
-	float scaledWolfDetectionRadius = wolfDetectionRadius * scaleFactor;
-	float minimumY = sheepStateMachine->GetWorld()->GetMinY();
-
 	if (escapeDirectionTimer >= directionChangeInterval)
 	{
-		randomDirectionOffset = { static_cast<float>(GetRandomValue(-100, 100)) / 100.0f,static_cast<float>(GetRandomValue(-100, 100)) / 100.0f };
+		randomDirectionOffset = { static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f,static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-100, 100)) / 100.0f };
 		escapeDirectionTimer = 0.0f;
 	}
 
 	Vector2 currentPosition = sheepStateMachine->GetPosition();
-	Vector2 closestWolfPosition = { 0, 0 };
 
-	const auto& wolves = sheepStateMachine->GetWorld()->GetWolves();
-
-	float closestDistance = scaledWolfDetectionRadius;
-
-	bool wolfFound = false;
-
-	for (const auto& wolf : wolves)
-	{
-		Vector2 wolfPosition = wolf->GetPosition();
+	ThreatField::Threat threat = sheepStateMachine->GetWorld()->GetThreatField().Sample(currentPosition);
 
-		float dx = currentPosition.x - wolfPosition.x;
-		float dy = currentPosition.y - wolfPosition.y;
-		float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
+	Vector2 closestWolfPosition = threat.wolfPosition;
 
-		if (distance < closestDistance)
-		{
-			closestDistance = distance;
-			closestWolfPosition = wolfPosition;
+	float wolfDx = currentPosition.x - closestWolfPosition.x;
+	float wolfDy = currentPosition.y - closestWolfPosition.y;
 
-			wolfFound = true;
-		}
-	}
+	bool wolfFound = threat.hasWolf && wolfDx * wolfDx + wolfDy * wolfDy < wolfDetectionRadius * wolfDetectionRadius;
 
 	if (!wolfFound)
 	{
 		if (sheepStateMachine->IsInGroup())
 		{
-			sheepStateMachine->SwitchState(std::make_unique<WanderingInGroupState>(sheepStateMachine));
+			sheepStateMachine->SwitchState<WanderingInGroupState>(sheepStateMachine);
 		}
 		else
 		{
-			sheepStateMachine->SwitchState(std::make_unique<WanderingAloneState>(sheepStateMachine));
+			sheepStateMachine->SwitchState<WanderingAloneState>(sheepStateMachine);
 		}
 		return;
 	}
@@ -597,7 +415,7 @@ void RunningAwayState::Tick(float deltaTime)
 			fleeDirection.y /= newLength;
 		}
 
-		Vector2 edgeAvoidance = CalculateEdgeAvoidance(currentPosition);
+		Vector2 edgeAvoidance = threat.edgeAvoidance;
 
 		fleeDirection.x += edgeAvoidance.x * edgeAvoidanceWeight;
 		fleeDirection.y += edgeAvoidance.y * edgeAvoidanceWeight;
@@ -612,65 +430,15 @@ void RunningAwayState::Tick(float deltaTime)
 
 		float speedMultiplier = 1.0f;
 
-		if (distance < scaledPanicDistance)
+		if (distance < ValueConfig::Sheep::PanicDistance)
 		{
 			speedMultiplier = ValueConfig::Sheep::PanicSpeedMultiplier;
 		}
 
-		currentPosition.x += fleeDirection.x * scaledFleeSpeed * speedMultiplier * deltaTime;
-		currentPosition.y += fleeDirection.y * scaledFleeSpeed * speedMultiplier * deltaTime;
-
-		if (scaleFactor <= 0.5f && currentPosition.y < minimumY)
-		{
-			currentPosition.y = minimumY;
-		}
-
-		float sheepSize = ValueConfig::World::CellSize * scaleFactor;
-		float rightMargin = 4.0f * scaleFactor;
-		float bottomMargin = 4.0f * scaleFactor;
-
-		float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - sheepSize - rightMargin);
-		float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - sheepSize - bottomMargin);
-
-		currentPosition.x = std::max(0.0f, std::min(currentPosition.x, maxX));
-		currentPosition.y = std::max(minimumY, std::min(currentPosition.y, maxY));
-
-		sheepStateMachine->SetPosition(currentPosition);
+		sheepStateMachine->SetDesiredVelocity({ fleeDirection.x * fleeSpeed * speedMultiplier, fleeDirection.y * fleeSpeed * speedMultiplier });
 	}
 }
 
-// Helper Function to Avoid getting trapped against screen edges.
-Vector2 RunningAwayState::CalculateEdgeAvoidance(const Vector2& position)
-{
-	Vector2 avoidance = { 0, 0 };
-
-	float scaleFactor = sheepStateMachine->GetWorld()->GetScaleFactor();
-	float borderMargin = ValueConfig::Sheep::EdgeAvoidanceMargin * scaleFactor;
-
-	float screenWidth = static_cast<float>(GetScreenWidth());
-	float screenHeight = static_cast<float>(GetScreenHeight());
-
-	if (position.x < borderMargin)
-	{
-		avoidance.x = 1.0f - (position.x / borderMargin);
-	}
-	else if (position.x > screenWidth - borderMargin)
-	{
-		avoidance.x = -1.0f * (1.0f - ((screenWidth - position.x) / borderMargin));
-	}
-
-	if (position.y < borderMargin)
-	{
-		avoidance.y = 1.0f - (position.y / borderMargin);
-	}
-	else if (position.y > screenHeight - borderMargin)
-	{
-		avoidance.y = -1.0f * (1.0f - ((screenHeight - position.y) / borderMargin));
-	}
-
-	return avoidance;
-}
-
 // Cleanup when exiting running away state.
 void RunningAwayState::Exit()
 {
@@ -705,9 +473,11 @@ void ReproducingState::Tick(float deltaTime)
 		{
 			int reproducingCount = sheepStateMachine->IsReproducing() ? 1 : 0;
 
-			for (auto member : sheepStateMachine->GetGroupMembers())
+			for (SheepHandle memberHandle : *sheepStateMachine->GetFlock())
 			{
-				if (member->IsReproducing())
+				SheepStateMachine* member = sheepStateMachine->GetWorld()->GetSheep(memberHandle);
+
+				if (member && member != sheepStateMachine && member->IsReproducing())
 				{
 					reproducingCount++;
 				}
@@ -715,55 +485,35 @@ void ReproducingState::Tick(float deltaTime)
 
 			int pairCount = reproducingCount / 2;
 
-			float scaleFactor = sheepStateMachine->GetWorld()->GetScaleFactor();
-
 			for (int i = 0; i < pairCount; i++)
 			{
 				Vector2 newSheepPosition = sheepStateMachine->GetPosition();
 
-				newSheepPosition.x += static_cast<float>(GetRandomValue(-20, 20)) * scaleFactor;
-				newSheepPosition.y += static_cast<float>(GetRandomValue(-20, 20)) * scaleFactor;
-
-				World* world = sheepStateMachine->GetWorld();
-				float minimumY = world->GetMinY();
-
-				if (scaleFactor <= 0.5f && newSheepPosition.y < minimumY)
-				{
-					newSheepPosition.y = minimumY;
-				}
-
-				float sheepSize = ValueConfig::World::CellSize * scaleFactor;
-				float rightMargin = 4.0f * scaleFactor;
-				float bottomMargin = 4.0f * scaleFactor;
-
-				float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - sheepSize - rightMargin);
-				float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - sheepSize - bottomMargin);
-
-				newSheepPosition.x = std::max(0.0f, std::min(newSheepPosition.x, maxX));
-				newSheepPosition.y = std::max(minimumY, std::min(newSheepPosition.y, maxY));
+				newSheepPosition.x += static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-20, 20));
+				newSheepPosition.y += static_cast<float>(sheepStateMachine->GetWorld()->RandomValue(-20, 20));
 
 				sheepStateMachine->RequestNewSheep(newSheepPosition);
 			}
 
-			for (auto member : sheepStateMachine->GetGroupMembers())
-			{
-				member->SetIsReproducing(false);
+			CommandBuffer& commands = sheepStateMachine->GetWorld()->GetCommandBuffer();
 
-				if (member->GetCurrentState() == SheepStateMachine::SheepState::Reproducing)
+			for (SheepHandle memberHandle : *sheepStateMachine->GetFlock())
+			{
+				if (memberHandle != sheepStateMachine->GetHandle())
 				{
-					member->SetCurrentState(SheepStateMachine::SheepState::WanderingInGroup);
+					commands.SetReproducing(memberHandle, false);
 				}
 			}
 		}
 
 		sheepStateMachine->SetIsReproducing(false);
 
-		sheepStateMachine->SwitchState(std::make_unique<WanderingInGroupState>(sheepStateMachine));
+		sheepStateMachine->SwitchState<WanderingInGroupState>(sheepStateMachine);
 	}
 }
 
 // Cleanup when exiting reproducing state.
 void ReproducingState::Exit()
 {
-	sheepStateMachine->ResetGroupTimer();
-}
+	sheepStateMachine->GetWorld()->GetFlockRegistry().ResetReproductionTimer(sheepStateMachine->GetGroupId());
+}
\ No newline at end of file
@@ -34,7 +34,7 @@ void SleepingState::Tick(float deltaTime)
 
 	if (wolfStateMachine->GetHunger() >= wolfStateMachine->GetHungerThreshold())
 	{
-		wolfStateMachine->SwitchState(std::make_unique<RoamingState>(wolfStateMachine));
+		wolfStateMachine->SwitchState<RoamingState>(wolfStateMachine);
 	}
 }
 
@@ -76,24 +76,9 @@ void RoamingState::Tick(float deltaTime)
 		movementTimer = 0.0f;
 	}
 
-	Vector2 currentPosition = wolfStateMachine->GetPosition();
-
-	float scaleFactor = wolfStateMachine->GetWorld()->GetScaleFactor();
-	float scaledSpeed = RuntimeConfig::WolfRoamSpeed() * scaleFactor;
-
-	currentPosition.x += moveDirection.x * scaledSpeed * deltaTime;
-	currentPosition.y += moveDirection.y * scaledSpeed * deltaTime;
+	float roamSpeed = RuntimeConfig::WolfRoamSpeed();
 
-	// Keep wolf within screen bounds
-	float minY = wolfStateMachine->GetWorld()->GetMinY();
-	float cellSize = ValueConfig::World::CellSize * scaleFactor;
-	float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - cellSize);
-	float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - cellSize);
-
-	currentPosition.x = std::max(0.0f, std::min(currentPosition.x, maxX));
-	currentPosition.y = std::max(minY, std::min(currentPosition.y, maxY));
-
-	wolfStateMachine->SetPosition(currentPosition);
+	wolfStateMachine->SetDesiredVelocity({ moveDirection.x * roamSpeed, moveDirection.y * roamSpeed });
 }
 
 // Cleanup when exiting roaming state.
@@ -134,15 +119,15 @@ void HuntingState::Tick(float deltaTime)
 	{
 		stateCheckTimer = 0.0f;
 
-		if (!targetSheep || !targetSheep->IsAlive())
+		if (!targetSheep)
 		{
 			wolfStateMachine->SetTargetSheep(nullptr);
-			wolfStateMachine->SwitchState(std::make_unique<RoamingState>(wolfStateMachine));
+			wolfStateMachine->SwitchState<RoamingState>(wolfStateMachine);
 			return;
 		}
 	}
 
-	if (!targetSheep || !targetSheep->IsAlive())
+	if (!targetSheep)
 	{
 		return;
 	}
@@ -159,23 +144,23 @@ void HuntingState::Tick(float deltaTime)
 	float dy = targetPosition.y - currentPosition.y;
 	float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
 
-	float scaleFactor = wolfStateMachine->GetWorld()->GetScaleFactor();
-	float scaledCellSize = ValueConfig::World::CellSize * scaleFactor;
-
-	if (distance < scaledCellSize)
+	if (distance < wolfStateMachine->GetWorld()->GetCellSize())
 	{
 		if (attackTimer >= attackInterval)
 		{
+			// The bite lands at the end of the tick, but the target is reserved for this wolf, so nothing else hurts it in between.
 			float newHealth = targetSheep->GetHealth() - RuntimeConfig::WolfAttackDamage();
 			newHealth = std::max(0.0f, newHealth);
-			targetSheep->SetHealth(newHealth);
 
-			wolfStateMachine->GetWorld()->AddBloodSplatter(targetSheep->GetPosition());
+			CommandBuffer& commands = wolfStateMachine->GetWorld()->GetCommandBuffer();
+			commands.DamageSheep(targetSheep->GetHandle(), RuntimeConfig::WolfAttackDamage());
+			commands.SpawnParticle(ParticleKind::Blood, targetSheep->GetPosition());
+
 			attackTimer = 0.0f;
 
 			if (newHealth <= 0.0f)
 			{
-				wolfStateMachine->SwitchState(std::make_unique<WolfEatingState>(wolfStateMachine));
+				wolfStateMachine->SwitchState<WolfEatingState>(wolfStateMachine);
 				return;
 			}
 		}
@@ -187,7 +172,7 @@ void HuntingState::Tick(float deltaTime)
 			dx = dx / distance;
 			dy = dy / distance;
 
-			float effectiveHuntSpeed = RuntimeConfig::WolfHuntSpeed() * scaleFactor;
+			float effectiveHuntSpeed = RuntimeConfig::WolfHuntSpeed();
 
 			if (wolfStateMachine->IsTired())
 			{
@@ -221,16 +206,7 @@ void HuntingState::Tick(float deltaTime)
 				dy /= newLength;
 			}
 
-			dx *= effectiveHuntSpeed * deltaTime;
-			dy *= effectiveHuntSpeed * deltaTime;
-
-			currentPosition.x += dx;
-			currentPosition.y += dy;
-
-			currentPosition.x = std::max(0.0f, std::min(currentPosition.x, static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - scaledCellSize)));
-			currentPosition.y = std::max(wolfStateMachine->GetWorld()->GetMinY(), std::min(currentPosition.y, static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - scaledCellSize)));
-
-			wolfStateMachine->SetPosition(currentPosition);
+			wolfStateMachine->SetDesiredVelocity({ dx * effectiveHuntSpeed, dy * effectiveHuntSpeed });
 		}
 	}
 }
@@ -241,41 +217,30 @@ Vector2 HuntingState::CalculateWolfSeparation()
 	Vector2 separationDirection = { 0.0f, 0.0f };
 	Vector2 wolfPosition = wolfStateMachine->GetPosition();
 
-	float scaleFactor = wolfStateMachine->GetWorld()->GetScaleFactor();
-	float scaledSeparationMinDistance = separationMinDistance * scaleFactor;
-	float scaledSeparationMinDistanceSquared = scaledSeparationMinDistance * scaledSeparationMinDistance;
-
-	const auto& wolves = wolfStateMachine->GetWorld()->GetWolves();
-
 	int neighborCount = 0;
 
-	for (const auto& otherWolf : wolves)
+	wolfStateMachine->GetWorld()->GetWolfGrid().QueryRadius(wolfPosition, separationMinDistance, [&](const WolfStateMachine* otherWolf)
 	{
-		if (otherWolf.get() == wolfStateMachine)
+		if (otherWolf == wolfStateMachine)
 		{
-			continue;
+			return;
 		}
 
 		Vector2 otherPositions = otherWolf->GetPosition();
 
 		float dx = wolfPosition.x - otherPositions.x;
 		float dy = wolfPosition.y - otherPositions.y;
-		float distanceSquared = dx * dx + dy * dy;
+		float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
+		float strength = 1.0f - (distance / separationMinDistance);
 
-		if (distanceSquared < scaledSeparationMinDistanceSquared)
+		if (distance > 0)
 		{
-			float distance = static_cast<float>(sqrt((distanceSquared)));
-			float strength = 1.0f - (distance / scaledSeparationMinDistance);
-
-			if (distance > 0)
-			{
-				separationDirection.x += (dx / distance) * strength;
-				separationDirection.y += (dy / distance) * strength;
-			}
-
-			neighborCount++;
+			separationDirection.x += (dx / distance) * strength;
+			separationDirection.y += (dy / distance) * strength;
 		}
-	}
+
+		neighborCount++;
+	});
 
 	if (neighborCount > 0)
 	{
@@ -324,7 +289,7 @@ void WolfEatingState::Tick(float deltaTime)
 	{
 		wolfStateMachine->SetHunger(0.0f);
 		wolfStateMachine->SetTargetSheep(nullptr);
-		wolfStateMachine->SwitchState(std::make_unique<ReturnToDenState>(wolfStateMachine));
+		wolfStateMachine->SwitchState<ReturnToDenState>(wolfStateMachine);
 	}
 }
 
@@ -356,42 +321,35 @@ void ReturnToDenState::Enter()
 // Manages wolf's movement back to its den.
 void ReturnToDenState::Tick(float deltaTime)
 {
-	float scaleFactor = wolfStateMachine->GetWorld()->GetScaleFactor();
-	float cellSize = ValueConfig::World::CellSize * scaleFactor;
-	float scaledReturnSpeed = returnSpeed * scaleFactor;
-	float scaledDenProximityThreshold = denProximityThreshold * scaleFactor;
+	(void)deltaTime;
 
-	Vector2 denPosition;
-	denPosition.x = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - cellSize * 2);
-	denPosition.y = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f) / 2;
+	const DenRegistry& dens = wolfStateMachine->GetWorld()->GetDens();
 
-	float minY = wolfStateMachine->GetWorld()->GetMinY();
-	float maxX = static_cast<float>(GetScreenWidth()) * 3.0f / 4.0f - cellSize;
-	float maxY = static_cast<float>(GetScreenHeight()) * 2.0f / 3.0f - cellSize;
+	int denIndex = wolfStateMachine->GetDenIndex();
 
-	denPosition.x = std::max(0.0f, std::min(denPosition.x, maxX));
-	denPosition.y = std::max(minY, std::min(denPosition.y, maxY));
+	if (denIndex < 0)
+	{
+		wolfStateMachine->SwitchState<SleepingState>(wolfStateMachine);
+		return;
+	}
 
+	Vector2 denPosition = dens.GetPosition(denIndex);
 	Vector2 wolfPosition = wolfStateMachine->GetPosition();
 
 	float dx = denPosition.x - wolfPosition.x;
 	float dy = denPosition.y - wolfPosition.y;
 	float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
 
-	if (distance < scaledDenProximityThreshold)
+	if (distance < denProximityThreshold)
 	{
 		wolfStateMachine->SetPosition(denPosition);
-		wolfStateMachine->SwitchState(std::make_unique<SleepingState>(wolfStateMachine));
+		wolfStateMachine->SwitchState<SleepingState>(wolfStateMachine);
 		return;
 	}
 
-	dx = (dx / distance) * scaledReturnSpeed * deltaTime;
-	dy = (dy / distance) * scaledReturnSpeed * deltaTime;
-
-	wolfPosition.x += dx;
-	wolfPosition.y += dy;
+	Vector2 direction = dens.GetDirectionHome(denIndex, wolfPosition);
 
-	wolfStateMachine->SetPosition(wolfPosition);
+	wolfStateMachine->SetDesiredVelocity({ direction.x * returnSpeed, direction.y * returnSpeed });
 }
 
 // Cleanup when exiting return to den state.
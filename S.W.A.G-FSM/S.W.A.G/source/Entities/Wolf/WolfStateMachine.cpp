@@ -6,33 +6,35 @@
 
 
 // Initializes a new wolf instance with its world reference and position.
-WolfStateMachine::WolfStateMachine(World* world, Vector2 position, float scaleFactor) : Entity(world, position), StateMachine(), world(world), position(position), isAlive(true), hunger(0.0f), stamina(RuntimeConfig::WolfStaminaMax()), targetSheep(nullptr), scaleFactor(scaleFactor)
+WolfStateMachine::WolfStateMachine(World* world, Vector2 position) : Entity(world, position), VariantStateMachine(), world(world), position(position), isAlive(true), hunger(0.0f), stamina(RuntimeConfig::WolfStaminaMax())
 {
-	float minY = world->GetMinY();
-	position.x = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f) - cellSize * scaleFactor * 2;
-	position.y = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f) / 2;
-
-	float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - cellSize * scaleFactor);
-	float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - cellSize * scaleFactor);
-
-	position.x = std::max(0.0f, std::min(position.x, maxX));
-	position.y = std::max(minY, std::min(position.y, maxY));
-
-	wolfTexture = LoadTexture("Assets/Wolf/TestWolf.png");
 }
 
 WolfStateMachine::~WolfStateMachine()
 {
-	UnloadTexture(wolfTexture);
 }
 
 // Sets up the initial state for the wolf and its starting conditions.
 void WolfStateMachine::Initialize()
 {
-	SwitchState(std::make_unique<SleepingState>(this));
+	SwitchState<SleepingState>(this);
 	currentWolfState = WolfState::Sleeping;
 }
 
+// Looks for a sheep to hunt while the wolf has no living prey, without changing anything in the world.
+void WolfStateMachine::Perceive()
+{
+	perceivedTarget = {};
+
+	if (world->GetSheep(targetSheep) || currentWolfState == WolfState::Eating || currentWolfState == WolfState::ReturnToDen)
+	{
+		return;
+	}
+
+	SheepStateMachine* target = FindNewTarget();
+	perceivedTarget = target ? target->GetHandle() : SheepHandle{};
+}
+
 // Updates wolf's vital stats over time and checks for nearby sheep.
 void WolfStateMachine::Sense(float deltaTime)
 {
@@ -46,16 +48,16 @@ void WolfStateMachine::Sense(float deltaTime)
 		stamina = std::min(stamina + ValueConfig::Wolf::StaminaRecoveryRate * deltaTime, RuntimeConfig::WolfStaminaMax());
 	}
 
-	if (targetSheep)
+	if (!targetSheep.IsNull())
 	{
-		if (!targetSheep->IsAlive())
+		if (!world->GetSheep(targetSheep))
 		{
 			if (Simulation* _simulation_ = dynamic_cast<Simulation*>(GetWorld()->GetSimulation()))
 			{
 				printf("Wolf clearing target - sheep is dead\n");
 			}
 
-			targetSheep = nullptr;
+			SetTargetSheep(nullptr);
 
 			if (currentWolfState == WolfState::Hunting)
 			{
@@ -64,16 +66,23 @@ void WolfStateMachine::Sense(float deltaTime)
 					printf("Wolf returning to roaming - target is gone\n");
 				}
 
-				SwitchState(std::make_unique<RoamingState>(this));
+				SwitchState<RoamingState>(this);
 			}
 		}
 	}
 
 	targetingTimer += deltaTime;
 
-	if (!targetSheep && currentWolfState != WolfState::Eating && currentWolfState != WolfState::ReturnToDen && targetingTimer >= targetAcquisitionDelay)
+	if (targetSheep.IsNull() && currentWolfState != WolfState::Eating && currentWolfState != WolfState::ReturnToDen && targetingTimer >= targetAcquisitionDelay)
 	{
-		FindNewTarget();
+		// Another wolf may have claimed the perceived sheep earlier this tick, so the reservation is checked again here.
+		SheepStateMachine* target = world->GetSheep(perceivedTarget);
+
+		if (target && target->IsAlive() && !world->IsSheepHuntedByOther(target, this))
+		{
+			SetTargetSheep(target);
+		}
+
 		targetingTimer = 0.0f;
 	}
 }
@@ -83,263 +92,85 @@ void WolfStateMachine::Decide(float deltaTime)
 {
 	(void)deltaTime;
 
-	if (currentWolfState == WolfState::Roaming && targetSheep != nullptr)
+	if (currentWolfState == WolfState::Roaming && GetTargetSheep() != nullptr)
 	{
-		SwitchState(std::make_unique<HuntingState>(this));
+		SwitchState<HuntingState>(this);
 	}
-	else if (currentWolfState == WolfState::Hunting && targetSheep == nullptr)
+	else if (currentWolfState == WolfState::Hunting && GetTargetSheep() == nullptr)
 	{
-		SwitchState(std::make_unique<RoamingState>(this));
+		SwitchState<RoamingState>(this);
 	}
 
 	if (currentWolfState == WolfState::Hunting && stamina <= 0.1f)
 	{
-		SwitchState(std::make_unique<RoamingState>(this));
+		SwitchState<RoamingState>(this);
 	}
 }
 
 // Executes the current state's behavior each frame.
 void WolfStateMachine::Act(float deltaTime)
 {
-	StateMachine::Update(deltaTime);
+	VariantStateMachine::Update(deltaTime);
 }
 
-// Renders the wolf on screen with color based on its current state.
-void WolfStateMachine::Draw()
+// Helper Function that Finds the nearest sheep that isn't being hunted by another wolf.
+SheepStateMachine* WolfStateMachine::FindNewTarget() const
 {
-	Color wolfColor;
-
-	Color otherStates = { 196, 180, 84, 255 };
-	Color tiredColor = { 160, 160, 160, 255 };
+	float detectionRadius = RuntimeConfig::WolfSheepDetectionRadius();
 
-	if (world->GetSimulation() && static_cast<Simulation*>(world->GetSimulation())->ShouldShowDetectionRadii())
+	return world->GetSheepGrid().FindNearest(position, detectionRadius, [this](const SheepStateMachine* target)
 	{
-		Vector2 centerForOutline = { position.x + cellSize * scaleFactor / 2, position.y + cellSize * scaleFactor / 2 };
-		Color outlineColor = { 0, 0, 0, 20 };
-
-		DrawCircleLines(static_cast<int>(centerForOutline.x), static_cast<int>(centerForOutline.y), RuntimeConfig::WolfSheepDetectionRadius() * scaleFactor, outlineColor);
-	}
-
-	Vector2 drawPosition = position;
+		return target->IsAlive() && !world->IsSheepHuntedByOther(target, this);
+	});
+}
 
-	float minY = world->GetMinY();
+// Switches the wolf's prey, releasing the previous hunt reservation and claiming the new one in the world.
+void WolfStateMachine::SetTargetSheep(SheepStateMachine* sheep)
+{
+	SheepHandle sheepHandle = sheep ? sheep->GetHandle() : SheepHandle{};
 
-	if (scaleFactor <= 0.5f && drawPosition.y < minY)
+	if (targetSheep == sheepHandle)
 	{
-		drawPosition.y = minY;
+		return;
 	}
 
-	float scaledCellSize = cellSize * scaleFactor;
-	Vector2 center = { drawPosition.x + scaledCellSize / 2, drawPosition.y + scaledCellSize / 2 };
-
-	Rectangle sourceRec = { 0.0f, 0.0f, static_cast<float>(wolfTexture.width), static_cast<float>(wolfTexture.height) };
-	Rectangle destRec = { drawPosition.x, drawPosition.y, scaledCellSize, scaledCellSize };
-	Vector2 origin = { 0.0f, 0.0f };
-
-	DrawTexturePro(wolfTexture, sourceRec, destRec, origin, 0.0f, WHITE);
-
-	switch (currentWolfState)
+	if (SheepStateMachine* previousSheep = world->GetSheep(targetSheep))
 	{
-	case WolfState::Sleeping:
-		wolfColor = BLACK;
-		break;
-	case WolfState::Roaming:
-		wolfColor = { 255, 255, 0, 255 };
-		break;
-	case WolfState::Hunting:
-		if (IsTired())
-		{
-			wolfColor = tiredColor;
-		}
-		else
-		{
-			wolfColor = { 128, 0, 0, 255 };
-		}
-		break;
-	case WolfState::Eating:
-		wolfColor = { 4, 102, 100, 255 };
-		break;
-	case WolfState::ReturnToDen:
-		wolfColor = { 128, 191, 51, 255 };
-		break;
-	default:
-		wolfColor = { 128, 128, 128, 255 };
-		break;
+		world->ReleaseHuntReservation(previousSheep, this);
 	}
 
-	float circleOffset = 5.0f * scaleFactor;
-	float circleScale = 0.3f;
-	float smallRadius = scaledCellSize / 2 * circleScale;
-
-	Vector2 circleCenter = { center.x, drawPosition.y + scaledCellSize + circleOffset };
-
-	DrawCircle(static_cast<int>(circleCenter.x), static_cast<int>(circleCenter.y), smallRadius, wolfColor);
-
-
-	Vector2 centerForStaminaBar = { drawPosition.x + scaledCellSize / 2, drawPosition.y + scaledCellSize / 2 };
-
-	DrawStatusBars(centerForStaminaBar, stamina);
-
-
-	DrawHuntingLine();
-}
-
-// Helper Function that Finds a new target sheep that isn't being hunted by another wolf.
-void WolfStateMachine::FindNewTarget()
-{
-	const auto& sheep = world->GetSheep();
-	const auto& wolves = world->GetWolves();
-
-	float closestDistance = RuntimeConfig::WolfSheepDetectionRadius() * scaleFactor;
-
-	SheepStateMachine* bestTarget = nullptr;
-
-	for (const auto& target : sheep)
-	{
-		if (!target->IsAlive())
-		{
-			continue;
-		}
-
-		bool beingHunted = false;
-
-		for (const auto& otherWolf : wolves)
-		{
-			if (otherWolf.get() != this && otherWolf->GetTargetSheep() == target.get())
-			{
-				beingHunted = true;
-				break;
-			}
-		}
-
-		if (beingHunted)
-		{
-			continue;
-		}
-
-		Vector2 sheepPosition = target->GetPosition();
-		Vector2 wolfPosition = GetPosition();
-
-		float dx = wolfPosition.x - sheepPosition.x;
-		float dy = wolfPosition.y - sheepPosition.y;
-		float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
+	targetSheep = sheepHandle;
 
-		if (distance < closestDistance)
-		{
-			closestDistance = distance;
-			bestTarget = target.get();
-		}
-	}
-
-	if (bestTarget)
+	if (sheep)
 	{
-		targetSheep = bestTarget;
+		world->ClaimHuntReservation(sheep, this);
 	}
 }
 
-// Helper Function that Draws a line from the wolf to the sheep it is hunting.
-void WolfStateMachine::DrawHuntingLine()
+// Returns the sheep this wolf is hunting, or null if it has none or the sheep died.
+SheepStateMachine* WolfStateMachine::GetTargetSheep() const
 {
-	if (currentWolfState == WolfState::Hunting && targetSheep != nullptr && targetSheep->IsAlive())
-	{
-		Vector2 drawPosition = position;
-
-		float minY = world->GetMinY();
-
-		if (scaleFactor <= 0.5f && drawPosition.y < minY)
-		{
-			drawPosition.y = minY;
-		}
-
-		Vector2 wolfCenter = { drawPosition.x + cellSize * scaleFactor / 2, drawPosition.y + cellSize * scaleFactor / 2 };
-		Vector2 sheepPosition = targetSheep->GetPosition();
-
-		if (scaleFactor <= 0.5f && sheepPosition.y < minY)
-		{
-			sheepPosition.y = minY;
-		}
-
-		Vector2 sheepCenter = { sheepPosition.x + cellSize * scaleFactor / 2, sheepPosition.y + cellSize * scaleFactor / 2 };
-
-		const int segments = 20;
-		const float segmentLength = 5.0f * scaleFactor;
-		Vector2 direction = { sheepCenter.x - wolfCenter.x, sheepCenter.y - wolfCenter.y };
-
-		float distance = static_cast<float>(sqrt(direction.x * direction.x + direction.y * direction.y));
-
-		if (distance > 0)
-		{
-			direction.x /= distance;
-			direction.y /= distance;
-
-			for (int i = 0; i < segments; i++)
-			{
-				if (i % 2 == 0)
-				{
-					float startDistance = i * segmentLength;
-
-					if (startDistance < distance)
-					{
-						Vector2 startPosition =
-						{
-							wolfCenter.x + direction.x * startDistance,
-							wolfCenter.y + direction.y * startDistance
-						};
-
-						float endDistance = std::min((i + 1) * segmentLength, distance);
-
-						Vector2 endPosition =
-						{
-							wolfCenter.x + direction.x * endDistance,
-							wolfCenter.y + direction.y * endDistance
-						};
-
-						DrawLineEx(startPosition, endPosition, 2.0f * scaleFactor, { 128, 0, 0, 255 });
-					}
-				}
-			}
-		}
-	}
+	return world->GetSheep(targetSheep);
 }
 
-// Sets the new position for the wolf, ensuring it stays within the world bounds.
-void WolfStateMachine::SetPosition(Vector2 newPosition)
+// Marks the wolf as dead and invalidates every handle other entities hold to it.
+void WolfStateMachine::Die()
 {
-	float minY = world->GetMinY();
-	float wolfSize = ValueConfig::World::CellSize * scaleFactor;
-	float rightMargin = 4.0f * scaleFactor;
-	float bottomMargin = 4.0f * scaleFactor;
-
-	float topOffset = 0.0f;
-
-	if (scaleFactor <= 0.5f)
+	if (!isAlive)
 	{
-		topOffset = 15.0f * scaleFactor;
+		return;
 	}
-	else if (scaleFactor >= 0.5f && scaleFactor <= 0.75f)
-	{
-		topOffset = 10.0f * scaleFactor;
-	}
-
-	float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - wolfSize - rightMargin);
-	float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - wolfSize - bottomMargin);
 
-	newPosition.x = std::max(0.0f, std::min(newPosition.x, maxX));
-	newPosition.y = std::max(minY + topOffset, std::min(newPosition.y, maxY));
+	isAlive = false;
 
-	position = newPosition;
+	world->ReleaseWolfHandle(handle);
 }
 
-// Draws the wolf's stamina and hunger bars on screen.
-void WolfStateMachine::DrawStatusBars(Vector2 barPosition, float staminaValue)
+// Places the wolf at a position straight away, clamped to the world's movement bounds. Ordinary movement goes through SetDesiredVelocity.
+void WolfStateMachine::SetPosition(Vector2 newPosition)
 {
-	const float barWidth = 30.0f * scaleFactor;
-	const float barHeight = 4.0f * scaleFactor;
-	const float barY = barPosition.y - cellSize * scaleFactor / 2 - 10.0f * scaleFactor;
-
-	DrawRectangle(static_cast<int>(barPosition.x - barWidth / 2), static_cast<int>(barY), static_cast<int>(barWidth), static_cast<int>(barHeight), GRAY);
+	newPosition = world->GetMovementBounds().Clamp(newPosition);
 
-	float staminaPercentage = staminaValue / RuntimeConfig::WolfStaminaMax();
-
-	DrawRectangle(static_cast<int>(barPosition.x - barWidth / 2), static_cast<int>(barY), static_cast<int>(barWidth * staminaPercentage), static_cast<int>(barHeight), { 128, 0, 32, 255 });
+	world->UpdateWolfPosition(this, position, newPosition);
+	position = newPosition;
 }
\ No newline at end of file
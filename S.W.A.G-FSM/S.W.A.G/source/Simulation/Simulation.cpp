@@ -3,11 +3,15 @@
 #include <Utility/TestingConfig.h>
 #include <Utility/ValueConfig.h>
 #include <Utility/WindowUtils.h>
+#include <Utility/JobSystem.h>
 
 #include <rlImGui.h>
 #include <raylib.h>
 #include <imgui.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <string>
 
 
@@ -41,9 +45,10 @@ Simulation::~Simulation()
 {
 	if (currentState == SimulationState::Running && world)
 	{
-		GrassStateMachine::CleanupTextures();
+		StopSimulation();
 
 		world.reset();
+		worldRenderer.reset();
 	}
 
 	ShutdownImGui();
@@ -148,7 +153,7 @@ void Simulation::ShutdownImGui()
 	rlImGuiShutdown();
 }
 
-// Processes world updates each frame using the current frame time.
+// Picks up the newest snapshot and console messages from the simulation thread and moves the camera over it. The world itself advances on its own thread.
 void Simulation::Update()
 {
 	if (IsKeyPressed(KEY_R))
@@ -156,12 +161,59 @@ void Simulation::Update()
 		showDetectionRadii = !showDetectionRadii;
 	}
 
+	TakeConsoleMessages();
+
 	if (currentState == SimulationState::Running && world)
 	{
-		world->Update(GetFrameTime());
+		snapshots.Acquire();
+
+		UpdateWorldCamera();
 	}
 }
 
+// Zooms the world view around the cursor with the mouse wheel and pans it while the right mouse button is held, keeping it over the world.
+void Simulation::UpdateWorldCamera()
+{
+	Rectangle viewport = { simulationViewport.x, simulationViewport.y, simulationViewport.width, simulationViewport.height };
+
+	Vector2 mousePosition = GetMousePosition();
+
+	worldCamera.offset = { viewport.x, viewport.y };
+	worldCamera.zoom = screenScaleFactor * viewZoom;
+
+	if (CheckCollisionPointRec(mousePosition, viewport))
+	{
+		float wheel = GetMouseWheelMove();
+
+		if (wheel != 0.0f)
+		{
+			Vector2 anchor = GetScreenToWorld2D(mousePosition, worldCamera);
+
+			viewZoom = std::clamp(viewZoom * powf(ValueConfig::Camera::ZoomStep, wheel), ValueConfig::Camera::MinZoom, ValueConfig::Camera::MaxZoom);
+			worldCamera.zoom = screenScaleFactor * viewZoom;
+
+			worldCamera.target.x = anchor.x - (mousePosition.x - viewport.x) / worldCamera.zoom;
+			worldCamera.target.y = anchor.y - (mousePosition.y - viewport.y) / worldCamera.zoom;
+		}
+
+		if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT))
+		{
+			Vector2 mouseDelta = GetMouseDelta();
+
+			worldCamera.target.x -= mouseDelta.x / worldCamera.zoom;
+			worldCamera.target.y -= mouseDelta.y / worldCamera.zoom;
+		}
+	}
+
+	float visibleWidth = viewport.width / worldCamera.zoom;
+	float visibleHeight = viewport.height / worldCamera.zoom;
+
+	Vector2 worldSize = snapshots.GetReadBuffer().worldSize;
+
+	worldCamera.target.x = std::clamp(worldCamera.target.x, 0.0f, std::max(0.0f, worldSize.x - visibleWidth));
+	worldCamera.target.y = std::clamp(worldCamera.target.y, 0.0f, std::max(0.0f, worldSize.y - visibleHeight));
+}
+
 // Calculates window dimensions for a given scale factor.
 void Simulation::CalculateWindowDimensions(float scaleFactor, int& outWidth, int& outHeight) const
 {
@@ -323,8 +375,6 @@ void Simulation::Draw()
 	}
 	else if (currentState == SimulationState::Running && world)
 	{
-		world->Draw();
-
 		DrawSimulationLayout();
 	}
 
@@ -421,6 +471,9 @@ void Simulation::DrawSetupUI()
 		ImGui::SliderInt("Initial Grass Count", &RuntimeConfig::Config.initialGrassCount, 0, 100, "%d");
 		ImGui::SliderInt("Initial Sheep Count", &RuntimeConfig::Config.initialSheepCount, 1, 30, "%d");
 		ImGui::SliderInt("Initial Wolf Count", &RuntimeConfig::Config.initialWolfCount, 0, 10, "%d");
+		ImGui::SliderInt("Worker Threads", &RuntimeConfig::Config.workerThreadCount, -1, static_cast<int>(JobSystem::DefaultWorkerCount()), RuntimeConfig::Config.workerThreadCount < 0 ? "Auto" : "%d");
+		ImGui::Checkbox("Parallel Sense", &RuntimeConfig::Config.parallelSense);
+		ImGui::Checkbox("Domain Decomposition", &RuntimeConfig::Config.domainDecomposition);
 
 
 		for (int i = 0; i < 7; i++)
@@ -753,7 +806,8 @@ void Simulation::RenderSheepSettings()
 
 	ImGui::Text("Group Behavior:");
 	ImGui::SliderFloat("Group Radius", &RuntimeConfig::Config.sheepConfig.groupRadius, 50.0f, 200.0f, "%.0f");
-	ImGui::SliderInt("Max Group Size", &RuntimeConfig::Config.sheepConfig.maxGroupSize, 2, 10);
+	ImGui::SliderInt("Max Group Size", &RuntimeConfig::Config.sheepConfig.maxGroupSize, 2, ValueConfig::Sheep::FlockCapacity);
+	ImGui::Checkbox("Shared Flock Perception", &RuntimeConfig::Config.sheepConfig.sharedFlockPerception);
 
 	ImGui::PopStyleColor();
 
@@ -852,13 +906,14 @@ void Simulation::DrawEntityStatusWindow()
 			ImGui::Separator();
 
 
-			const auto& grasses = world->GetGrasses();
+			const RenderSnapshot& snapshot = snapshots.GetReadBuffer();
+
 			int grassCount = 0;
 
-			for (const auto& grass : grasses)
+			for (const GrassSnapshot& grass : snapshot.grass)
 			{
 				std::string stateStr;
-				switch (grass->GetCurrentState())
+				switch (grass.state)
 				{
 				case GrassStateMachine::GrassState::SeedsPlanted:
 					stateStr = "Seeds Planted";
@@ -876,7 +931,7 @@ void Simulation::DrawEntityStatusWindow()
 
 				std::string statusText = "Grass #" + std::to_string(++grassCount) + ": " + stateStr;
 
-				if (grass->IsBeingEaten())
+				if (grass.beingEaten)
 				{
 					statusText += " (Being Eaten)";
 				}
@@ -887,14 +942,13 @@ void Simulation::DrawEntityStatusWindow()
 
 
 
-			const auto& sheeps = world->GetSheep();
 			int sheepCount = 0;
 
-			for (const auto& sheep : sheeps)
+			for (const SheepSnapshot& sheep : snapshot.sheep)
 			{
 				std::string stateStr;
 
-				switch (sheep->GetCurrentState())
+				switch (sheep.activity)
 				{
 				case SheepStateMachine::SheepState::WanderingAlone:
 					stateStr = "Wandering Alone";
@@ -921,9 +975,9 @@ void Simulation::DrawEntityStatusWindow()
 
 				std::string groupStatus;
 
-				if (sheep->IsInGroup())
+				if (sheep.inGroup)
 				{
-					if (sheep->IsGroupLeader())
+					if (sheep.groupLeader)
 					{
 						groupStatus = " (Group Leader)";
 					}
@@ -937,7 +991,7 @@ void Simulation::DrawEntityStatusWindow()
 					groupStatus = " (No Group)";
 				}
 
-				std::string healthInfo = " H:" + std::to_string(static_cast<int>(sheep->GetHealth())) + " F:" + std::to_string(static_cast<int>(sheep->GetHunger()));
+				std::string healthInfo = " H:" + std::to_string(static_cast<int>(sheep.health)) + " F:" + std::to_string(static_cast<int>(sheep.hunger));
 
 				ImGui::Text("Sheep #%d: %s%s%s", ++sheepCount, stateStr.c_str(), groupStatus.c_str(), healthInfo.c_str());
 			}
@@ -945,13 +999,12 @@ void Simulation::DrawEntityStatusWindow()
 
 
 
-			const auto& wolves = world->GetWolves();
 			int wolfCount = 0;
 
-			for (const auto& wolf : wolves)
+			for (const WolfSnapshot& wolf : snapshot.wolves)
 			{
 				std::string stateStr;
-				switch (wolf->GetCurrentState())
+				switch (wolf.state)
 				{
 				case WolfStateMachine::WolfState::Sleeping:
 					stateStr = "Sleeping";
@@ -975,12 +1028,12 @@ void Simulation::DrawEntityStatusWindow()
 
 				std::string targetInfo;
 
-				if (wolf->GetTargetSheep() != nullptr)
+				if (wolf.hasTarget)
 				{
 					targetInfo = " (Targeting Sheep)";
 				}
 
-				std::string hungerInfo = " H:" + std::to_string(static_cast<int>(wolf->GetHunger())) + " S:" + std::to_string(static_cast<int>(wolf->GetStamina()));
+				std::string hungerInfo = " H:" + std::to_string(static_cast<int>(wolf.hunger)) + " S:" + std::to_string(static_cast<int>(wolf.stamina));
 
 				ImGui::Text("Wolf #%d: %s%s%s", ++wolfCount, stateStr.c_str(), targetInfo.c_str(), hungerInfo.c_str());
 			}
@@ -1036,14 +1089,18 @@ void Simulation::DrawSimulationLayout()
 	RenderSimulationInViewport();
 }
 
-// Renders the simulation world within the viewport area.
+// Renders the simulation world within the viewport area, mapping world units onto the screen through the camera.
 void Simulation::RenderSimulationInViewport()
 {
+	Rectangle visibleArea = { worldCamera.target.x, worldCamera.target.y, simulationViewport.width / worldCamera.zoom, simulationViewport.height / worldCamera.zoom };
+
 	BeginScissorMode((int)simulationViewport.x, (int)simulationViewport.y, (int)simulationViewport.width, (int)simulationViewport.height);
 
 	DrawRectangle((int)simulationViewport.x, (int)simulationViewport.y, (int)simulationViewport.width, (int)simulationViewport.height, RAYWHITE);
 
-	world->Draw();
+	BeginMode2D(worldCamera);
+	worldRenderer->Draw(snapshots.GetReadBuffer(), visibleArea, worldCamera.zoom, showDetectionRadii);
+	EndMode2D();
 
 	DrawRectangleLines((int)simulationViewport.x, (int)simulationViewport.y, (int)simulationViewport.width, (int)simulationViewport.height, RED);
 
@@ -1140,6 +1197,7 @@ void Simulation::DrawLegendPanel()
 		}
 		ImGui::Checkbox("Show Detection Radii (R)", &showDetectionRadii);
 		ImGui::Text("Toggle visibility of detection ranges");
+		ImGui::Text("Mouse wheel to zoom, right drag to pan");
 	}
 	ImGui::End();
 }
@@ -1228,15 +1286,102 @@ void Simulation::DrawConsoleWindow()
 // Starts the simulation with the current setup parameters.
 void Simulation::StartSimulation()
 {
-	float scaledCellSize = ValueConfig::World::CellSize * screenScaleFactor;
+	// Size the world in world units from the unscaled viewport, the camera takes care of the display scale.
+	float viewportCellSize = cellSize * screenScaleFactor;
 
-	int worldWidth = static_cast<int>(simulationViewport.width / scaledCellSize);
-	int worldHeight = static_cast<int>(simulationViewport.height / scaledCellSize);
+	int worldWidth = static_cast<int>(simulationViewport.width / viewportCellSize);
+	int worldHeight = static_cast<int>(simulationViewport.height / viewportCellSize);
 
-	world = std::make_unique<World>(worldWidth, worldHeight, ValueConfig::World::CellSize, simulationViewport.y, screenScaleFactor, this);
+	world = std::make_unique<World>(worldWidth, worldHeight, cellSize, this);
 	world->Initialize(initialGrassCount, initialSheepCount, initialWolfCount);
 
+	// The first snapshot is taken here so there is something to draw before the simulation thread published its first tick.
+	world->WriteSnapshot(snapshots.GetWriteBuffer());
+	snapshots.Publish();
+	snapshots.Acquire();
+
+	worldRenderer = std::make_unique<WorldRenderer>();
+
+	viewZoom = 1.0f;
+	worldCamera.target = { 0.0f, 0.0f };
+	worldCamera.zoom = screenScaleFactor;
+
 	currentState = SimulationState::Running;
+
+	simulationRunning = true;
+	simulationThread = std::thread(&Simulation::RunSimulationThread, this);
+}
+
+// Asks the simulation thread to finish its current tick and waits for it to exit.
+void Simulation::StopSimulation()
+{
+	simulationRunning = false;
+
+	if (simulationThread.joinable())
+	{
+		simulationThread.join();
+	}
+}
+
+// Advances the world in fixed steps at the tick rate, independent of how fast the window draws, and publishes a snapshot after each batch of ticks.
+// After falling far behind, only a few ticks are caught up on and the rest of the backlog is dropped, so a slow tick never snowballs.
+void Simulation::RunSimulationThread()
+{
+	using Clock = std::chrono::steady_clock;
+
+	const Clock::duration tickInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(ValueConfig::World::TickInterval));
+
+	Clock::time_point nextTick = Clock::now();
+
+	while (simulationRunning)
+	{
+		int ticks = 0;
+
+		while (Clock::now() >= nextTick && ticks < ValueConfig::World::MaxCatchUpTicks)
+		{
+			world->Update(ValueConfig::World::TickInterval);
+
+			nextTick += tickInterval;
+			ticks++;
+		}
+
+		if (ticks > 0)
+		{
+			world->WriteSnapshot(snapshots.GetWriteBuffer());
+			snapshots.Publish();
+		}
+
+		if (Clock::now() >= nextTick)
+		{
+			nextTick = Clock::now();
+		}
+
+		std::this_thread::sleep_until(nextTick);
+	}
+}
+
+// Queues a message for the console. Entities call this from the simulation thread, so it only touches the pending list under the lock.
+void Simulation::AddConsoleMessage(const std::string& message)
+{
+	std::lock_guard<std::mutex> lock(consoleMutex);
+
+	pendingConsoleMessages.push_back(message);
+}
+
+// Moves the queued messages into the console the window draws, keeping only the newest ones.
+void Simulation::TakeConsoleMessages()
+{
+	{
+		std::lock_guard<std::mutex> lock(consoleMutex);
+
+		consoleMessages.insert(consoleMessages.end(), std::make_move_iterator(pendingConsoleMessages.begin()), std::make_move_iterator(pendingConsoleMessages.end()));
+		pendingConsoleMessages.clear();
+	}
+
+	if (consoleMessages.size() > 1000)
+	{
+		consoleMessages.erase(consoleMessages.begin(), consoleMessages.end() - 1000);
+	}
 }
 
 // Helper Function that Redirects printf to the console.
@@ -1248,12 +1393,7 @@ void Simulation::ConsoleOutputCallback(const char* text, void* userData)
 	}
 
 	Simulation* _simulation = static_cast<Simulation*>(userData);
-	_simulation->consoleMessages.push_back(text);
-
-	if (_simulation->consoleMessages.size() > 1000)
-	{
-		_simulation->consoleMessages.erase(_simulation->consoleMessages.begin());
-	}
+	_simulation->AddConsoleMessage(text);
 }
 
 // Centers the window on the screen based on the given width and height.
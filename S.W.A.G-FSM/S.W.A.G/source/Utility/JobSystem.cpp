@@ -0,0 +1,211 @@
+#include <Utility/JobSystem.h>
+
+#include <algorithm>
+
+
+namespace
+{
+	// Zero on every thread the job system did not start, so callers can keep per-thread data in slot zero.
+	thread_local unsigned int currentThreadIndex = 0;
+}
+
+
+// Creates a deque for the calling thread and one for each worker, then starts the workers, which sleep until jobs arrive.
+JobSystem::JobSystem(unsigned int workerCount)
+{
+	for (unsigned int i = 0; i <= workerCount; i++)
+	{
+		queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	workers.reserve(workerCount);
+
+	for (unsigned int i = 0; i < workerCount; i++)
+	{
+		workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+	}
+}
+
+// Wakes every worker so it can see the job system is stopping, then waits for all of them to exit.
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+
+	wake.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+// Pushes a job onto the calling thread's deque and wakes a worker to steal it, counting it against the counter until it has run.
+void JobSystem::Submit(Job job, JobCounter& counter)
+{
+	counter.fetch_add(1);
+
+	WorkQueue& queue = *queues[GetCurrentThreadIndex()];
+
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		queue.jobs.push_back([job = std::move(job), &counter]()
+		{
+			job();
+			counter.fetch_sub(1);
+		});
+	}
+
+	queuedJobs.fetch_add(1);
+
+	// Taking the lock orders the wake-up after any worker that just found nothing to do has started waiting.
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+
+	wake.notify_one();
+}
+
+// Runs jobs from this thread's deque or other threads' until every job counted against the counter has finished.
+void JobSystem::Wait(const JobCounter& counter)
+{
+	unsigned int threadIndex = GetCurrentThreadIndex();
+
+	while (counter.load() > 0)
+	{
+		if (!TryRunJob(threadIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+// Calls the task on disjoint chunks of at most grainSize indices that together cover [0, count), returning once all of them ran.
+// Small ranges, or a job system without workers, are handled on the calling thread alone so they skip the scheduling cost.
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const RangeTask& task)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	grainSize = std::max<size_t>(grainSize, 1);
+
+	if (workers.empty() || count <= grainSize)
+	{
+		task(0, count);
+		return;
+	}
+
+	JobCounter counter = 0;
+
+	// The first chunk is kept for the calling thread, which would otherwise only pop it straight back off its deque.
+	for (size_t begin = grainSize; begin < count; begin += grainSize)
+	{
+		size_t end = std::min(begin + grainSize, count);
+
+		Submit([&task, begin, end]() { task(begin, end); }, counter);
+	}
+
+	task(0, grainSize);
+
+	Wait(counter);
+}
+
+// Leaves a single hardware thread to the creating thread, which takes part in every job itself.
+unsigned int JobSystem::DefaultWorkerCount()
+{
+	unsigned int hardwareThreads = std::thread::hardware_concurrency();
+
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+// Returns the index of the calling thread's deque, which is one above its position among the workers or zero for any other thread.
+unsigned int JobSystem::GetCurrentThreadIndex()
+{
+	return currentThreadIndex;
+}
+
+// Runs whatever jobs it can find and sleeps while there are none, until the job system stops.
+void JobSystem::WorkerLoop(unsigned int threadIndex)
+{
+	currentThreadIndex = threadIndex;
+
+	while (true)
+	{
+		if (TryRunJob(threadIndex))
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+
+		wake.wait(lock, [this]() { return stopping || queuedJobs.load() > 0; });
+
+		if (stopping)
+		{
+			return;
+		}
+	}
+}
+
+// Runs one job from the thread's own deque, or stolen from another, returning false if every deque was empty.
+bool JobSystem::TryRunJob(unsigned int threadIndex)
+{
+	Job job;
+
+	if (!PopJob(threadIndex, job) && !StealJob(threadIndex, job))
+	{
+		return false;
+	}
+
+	queuedJobs.fetch_sub(1);
+
+	job();
+
+	return true;
+}
+
+// Takes the newest job of the thread's own deque, which is the one most likely to still have its data in cache.
+bool JobSystem::PopJob(unsigned int threadIndex, Job& job)
+{
+	WorkQueue& queue = *queues[threadIndex];
+
+	std::lock_guard<std::mutex> lock(queue.mutex);
+
+	if (queue.jobs.empty())
+	{
+		return false;
+	}
+
+	job = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+
+	return true;
+}
+
+// Takes the oldest job of the first other thread that has one, trying them in turn starting after this one.
+bool JobSystem::StealJob(unsigned int threadIndex, Job& job)
+{
+	size_t queueCount = queues.size();
+
+	for (size_t offset = 1; offset < queueCount; offset++)
+	{
+		WorkQueue& queue = *queues[(threadIndex + offset) % queueCount];
+
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+
+			return true;
+		}
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <Utility/PhaseGraph.h>
+
+
+// Declares a step of the frame. Dependencies have to be declared before the steps that wait on them, which also rules out cycles.
+PhaseGraph::PhaseId PhaseGraph::AddPhase(std::function<void()> work, std::initializer_list<PhaseId> dependencies)
+{
+	PhaseId id = static_cast<PhaseId>(phases.size());
+
+	phases.push_back({ std::move(work), {}, static_cast<int>(dependencies.size()) });
+
+	for (PhaseId dependency : dependencies)
+	{
+		phases[dependency].dependents.push_back(id);
+	}
+
+	return id;
+}
+
+// Starts the steps that wait on nothing and returns once every step has run, helping with the work in the meantime.
+void PhaseGraph::Run(JobSystem& jobs)
+{
+	if (pendingDependencies.size() != phases.size())
+	{
+		pendingDependencies = std::vector<std::atomic<int>>(phases.size());
+	}
+
+	for (size_t i = 0; i < phases.size(); i++)
+	{
+		pendingDependencies[i].store(phases[i].dependencyCount);
+	}
+
+	JobCounter counter = 0;
+
+	for (PhaseId id = 0; id < static_cast<PhaseId>(phases.size()); id++)
+	{
+		if (phases[id].dependencyCount == 0)
+		{
+			Schedule(jobs, id, counter);
+		}
+	}
+
+	jobs.Wait(counter);
+}
+
+// Submits the step as a job that, once done, schedules every step it was the last dependency of.
+// Those are submitted before this job counts as finished, so the counter cannot reach zero while steps are still left.
+void PhaseGraph::Schedule(JobSystem& jobs, PhaseId id, JobCounter& counter)
+{
+	jobs.Submit([this, &jobs, id, &counter]()
+	{
+		phases[id].work();
+
+		for (PhaseId dependent : phases[id].dependents)
+		{
+			if (pendingDependencies[dependent].fetch_sub(1) == 1)
+			{
+				Schedule(jobs, dependent, counter);
+			}
+		}
+	}, counter);
+}
\ No newline at end of file
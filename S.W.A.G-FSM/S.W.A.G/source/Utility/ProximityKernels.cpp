@@ -0,0 +1,255 @@
+#include <Utility/ProximityKernels.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PROXIMITY_KERNELS_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROXIMITY_KERNELS_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define PROXIMITY_KERNELS_NEON
+#endif
+
+
+namespace
+{
+	// Continues a nearest search over the points from begin to end, only accepting points strictly closer than the best so far.
+	size_t FindNearestScalar(const float* positionsX, const float* positionsY, size_t begin, size_t end, Vector2 center, float& bestDistanceSquared, size_t bestIndex)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			float dx = positionsX[i] - center.x;
+			float dy = positionsY[i] - center.y;
+			float distanceSquared = dx * dx + dy * dy;
+
+			if (distanceSquared < bestDistanceSquared)
+			{
+				bestDistanceSquared = distanceSquared;
+				bestIndex = i;
+			}
+		}
+
+		return bestIndex;
+	}
+
+	// Writes the radius mask for the points from begin to end and returns how many of them are within.
+	size_t MaskWithinRadiusScalar(const float* positionsX, const float* positionsY, size_t begin, size_t end, Vector2 center, float radiusSquared, uint8_t* mask)
+	{
+		size_t within = 0;
+
+		for (size_t i = begin; i < end; i++)
+		{
+			float dx = positionsX[i] - center.x;
+			float dy = positionsY[i] - center.y;
+
+			mask[i] = (dx * dx + dy * dy < radiusSquared) ? 1 : 0;
+			within += mask[i];
+		}
+
+		return within;
+	}
+
+	// Picks the overall winner from per-lane bests, preferring the lowest index among equal distances so every path matches the scalar one.
+	size_t ReduceLanes(const float* laneDistances, const int32_t* laneIndices, int laneCount, float& bestDistanceSquared)
+	{
+		size_t bestIndex = ProximityKernels::NotFound;
+
+		for (int lane = 0; lane < laneCount; lane++)
+		{
+			if (laneIndices[lane] < 0)
+			{
+				continue;
+			}
+
+			size_t index = static_cast<size_t>(laneIndices[lane]);
+
+			if (laneDistances[lane] < bestDistanceSquared || (laneDistances[lane] == bestDistanceSquared && index < bestIndex))
+			{
+				bestDistanceSquared = laneDistances[lane];
+				bestIndex = index;
+			}
+		}
+
+		return bestIndex;
+	}
+}
+
+
+namespace ProximityKernels
+{
+	// Keeps a running best distance and index per lane, then reduces the lanes and finishes the leftover points one at a time.
+	size_t FindNearest(const float* positionsX, const float* positionsY, size_t count, Vector2 center, float maxDistanceSquared)
+	{
+		size_t i = 0;
+		size_t bestIndex = NotFound;
+
+		float bestDistanceSquared = maxDistanceSquared;
+
+#if defined(PROXIMITY_KERNELS_AVX2)
+		if (count >= 8)
+		{
+			__m256 centerX = _mm256_set1_ps(center.x);
+			__m256 centerY = _mm256_set1_ps(center.y);
+			__m256 laneBest = _mm256_set1_ps(maxDistanceSquared);
+			__m256i laneBestIndex = _mm256_set1_epi32(-1);
+			__m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+			__m256i step = _mm256_set1_epi32(8);
+
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(positionsX + i), centerX);
+				__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(positionsY + i), centerY);
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 closer = _mm256_cmp_ps(distanceSquared, laneBest, _CMP_LT_OQ);
+
+				laneBest = _mm256_blendv_ps(laneBest, distanceSquared, closer);
+				laneBestIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(laneBestIndex), _mm256_castsi256_ps(laneIndex), closer));
+				laneIndex = _mm256_add_epi32(laneIndex, step);
+			}
+
+			alignas(32) float laneDistances[8];
+			alignas(32) int32_t laneIndices[8];
+
+			_mm256_store_ps(laneDistances, laneBest);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(laneIndices), laneBestIndex);
+
+			bestIndex = ReduceLanes(laneDistances, laneIndices, 8, bestDistanceSquared);
+		}
+#elif defined(PROXIMITY_KERNELS_SSE)
+		if (count >= 4)
+		{
+			__m128 centerX = _mm_set1_ps(center.x);
+			__m128 centerY = _mm_set1_ps(center.y);
+			__m128 laneBest = _mm_set1_ps(maxDistanceSquared);
+			__m128i laneBestIndex = _mm_set1_epi32(-1);
+			__m128i laneIndex = _mm_setr_epi32(0, 1, 2, 3);
+			__m128i step = _mm_set1_epi32(4);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 dx = _mm_sub_ps(_mm_loadu_ps(positionsX + i), centerX);
+				__m128 dy = _mm_sub_ps(_mm_loadu_ps(positionsY + i), centerY);
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 closer = _mm_cmplt_ps(distanceSquared, laneBest);
+				__m128i closerBits = _mm_castps_si128(closer);
+
+				laneBest = _mm_or_ps(_mm_and_ps(closer, distanceSquared), _mm_andnot_ps(closer, laneBest));
+				laneBestIndex = _mm_or_si128(_mm_and_si128(closerBits, laneIndex), _mm_andnot_si128(closerBits, laneBestIndex));
+				laneIndex = _mm_add_epi32(laneIndex, step);
+			}
+
+			alignas(16) float laneDistances[4];
+			alignas(16) int32_t laneIndices[4];
+
+			_mm_store_ps(laneDistances, laneBest);
+			_mm_store_si128(reinterpret_cast<__m128i*>(laneIndices), laneBestIndex);
+
+			bestIndex = ReduceLanes(laneDistances, laneIndices, 4, bestDistanceSquared);
+		}
+#elif defined(PROXIMITY_KERNELS_NEON)
+		if (count >= 4)
+		{
+			float32x4_t centerX = vdupq_n_f32(center.x);
+			float32x4_t centerY = vdupq_n_f32(center.y);
+			float32x4_t laneBest = vdupq_n_f32(maxDistanceSquared);
+			int32x4_t laneBestIndex = vdupq_n_s32(-1);
+			const int32_t firstIndices[4] = { 0, 1, 2, 3 };
+			int32x4_t laneIndex = vld1q_s32(firstIndices);
+			int32x4_t step = vdupq_n_s32(4);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4_t dx = vsubq_f32(vld1q_f32(positionsX + i), centerX);
+				float32x4_t dy = vsubq_f32(vld1q_f32(positionsY + i), centerY);
+				float32x4_t distanceSquared = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+				uint32x4_t closer = vcltq_f32(distanceSquared, laneBest);
+
+				laneBest = vbslq_f32(closer, distanceSquared, laneBest);
+				laneBestIndex = vbslq_s32(closer, laneIndex, laneBestIndex);
+				laneIndex = vaddq_s32(laneIndex, step);
+			}
+
+			float laneDistances[4];
+			int32_t laneIndices[4];
+
+			vst1q_f32(laneDistances, laneBest);
+			vst1q_s32(laneIndices, laneBestIndex);
+
+			bestIndex = ReduceLanes(laneDistances, laneIndices, 4, bestDistanceSquared);
+		}
+#endif
+
+		return FindNearestScalar(positionsX, positionsY, i, count, center, bestDistanceSquared, bestIndex);
+	}
+
+	// Compares whole vectors of points against the radius at once and expands each comparison result into the byte mask.
+	size_t MaskWithinRadius(const float* positionsX, const float* positionsY, size_t count, Vector2 center, float radiusSquared, uint8_t* mask)
+	{
+		size_t i = 0;
+		size_t within = 0;
+
+#if defined(PROXIMITY_KERNELS_AVX2)
+		__m256 centerX = _mm256_set1_ps(center.x);
+		__m256 centerY = _mm256_set1_ps(center.y);
+		__m256 limit = _mm256_set1_ps(radiusSquared);
+
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(positionsX + i), centerX);
+			__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(positionsY + i), centerY);
+			__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+			int bits = _mm256_movemask_ps(_mm256_cmp_ps(distanceSquared, limit, _CMP_LT_OQ));
+
+			for (int lane = 0; lane < 8; lane++)
+			{
+				mask[i + lane] = static_cast<uint8_t>((bits >> lane) & 1);
+				within += mask[i + lane];
+			}
+		}
+#elif defined(PROXIMITY_KERNELS_SSE)
+		__m128 centerX = _mm_set1_ps(center.x);
+		__m128 centerY = _mm_set1_ps(center.y);
+		__m128 limit = _mm_set1_ps(radiusSquared);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 dx = _mm_sub_ps(_mm_loadu_ps(positionsX + i), centerX);
+			__m128 dy = _mm_sub_ps(_mm_loadu_ps(positionsY + i), centerY);
+			__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+			int bits = _mm_movemask_ps(_mm_cmplt_ps(distanceSquared, limit));
+
+			for (int lane = 0; lane < 4; lane++)
+			{
+				mask[i + lane] = static_cast<uint8_t>((bits >> lane) & 1);
+				within += mask[i + lane];
+			}
+		}
+#elif defined(PROXIMITY_KERNELS_NEON)
+		float32x4_t centerX = vdupq_n_f32(center.x);
+		float32x4_t centerY = vdupq_n_f32(center.y);
+		float32x4_t limit = vdupq_n_f32(radiusSquared);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t dx = vsubq_f32(vld1q_f32(positionsX + i), centerX);
+			float32x4_t dy = vsubq_f32(vld1q_f32(positionsY + i), centerY);
+			float32x4_t distanceSquared = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+
+			uint32_t lanes[4];
+
+			vst1q_u32(lanes, vcltq_f32(distanceSquared, limit));
+
+			for (int lane = 0; lane < 4; lane++)
+			{
+				mask[i + lane] = static_cast<uint8_t>(lanes[lane] & 1);
+				within += mask[i + lane];
+			}
+		}
+#endif
+
+		return within + MaskWithinRadiusScalar(positionsX, positionsY, i, count, center, radiusSquared, mask);
+	}
+}
\ No newline at end of file
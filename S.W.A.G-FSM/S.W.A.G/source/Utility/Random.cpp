@@ -0,0 +1,30 @@
+#include <Utility/Random.h>
+
+#include <utility>
+
+
+// Returns a value between min and max, both included, swapping them when given the wrong way round just like raylib's GetRandomValue.
+int Random::GetValue(int min, int max)
+{
+	if (min > max)
+	{
+		std::swap(min, max);
+	}
+
+	uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+
+	return static_cast<int>(min + static_cast<int64_t>(Next() % range));
+}
+
+// Steps the state by a fixed odd increment and scrambles it, in the manner of SplitMix64.
+uint64_t Random::Next()
+{
+	state += 0x9E3779B97F4A7C15ull;
+
+	uint64_t value = state;
+
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+	return value ^ (value >> 31);
+}
\ No newline at end of file
@@ -2,32 +2,17 @@
 
 
 // Initializes a new state machine with no active state.
-StateMachine::StateMachine() : currentState(nullptr)
+StateMachine::StateMachine() : currentState(nullptr), releaseCurrentState(nullptr)
 {
 }
 
-// Cleans up the current state if one exists by calling its exit method.
+// Cleans up the current state if one exists by calling its exit method and returning it to its pool.
 StateMachine::~StateMachine()
 {
 	if (currentState)
 	{
 		currentState->Exit();
-	}
-}
-
-// Handles the transition between states, ensuring proper cleanup and initialization.
-void StateMachine::SwitchState(std::unique_ptr<State> newState)
-{
-	if (currentState)
-	{
-		currentState->Exit();
-	}
-
-	currentState = std::move(newState);
-
-	if (currentState)
-	{
-		currentState->Enter();
+		releaseCurrentState(currentState);
 	}
 }
 
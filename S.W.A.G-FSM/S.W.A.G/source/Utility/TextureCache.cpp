@@ -0,0 +1,107 @@
+#include <Utility/TextureCache.h>
+
+#include <utility>
+
+
+// Shares the texture of another handle, keeping it loaded for this handle as well.
+TextureHandle::TextureHandle(const TextureHandle& other) : cache(other.cache), slot(other.slot)
+{
+	if (cache)
+	{
+		cache->AddReference(slot);
+	}
+}
+
+// Takes over the reference held by another handle, leaving it empty.
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept : cache(other.cache), slot(other.slot)
+{
+	other.cache = nullptr;
+}
+
+// Gives the reference back to the cache, which unloads the texture once nobody uses it.
+TextureHandle::~TextureHandle()
+{
+	if (cache)
+	{
+		cache->Release(slot);
+	}
+}
+
+// Replaces the referenced texture, releasing the previous one when the argument goes out of scope.
+TextureHandle& TextureHandle::operator=(TextureHandle other) noexcept
+{
+	std::swap(cache, other.cache);
+	std::swap(slot, other.slot);
+
+	return *this;
+}
+
+// Returns the shared texture, or an empty texture that draws nothing when the handle is empty.
+const Texture2D& TextureHandle::Get() const
+{
+	static const Texture2D emptyTexture = {};
+
+	return cache ? cache->entries[slot].texture : emptyTexture;
+}
+
+// Unloads any texture still held by a handle that outlived its users.
+TextureCache::~TextureCache()
+{
+	for (const auto& [path, slot] : texturesByPath)
+	{
+		UnloadTexture(entries[slot].texture);
+	}
+}
+
+// Returns a handle to the texture at the path, loading it from disk only if no handle currently references it.
+TextureHandle TextureCache::Acquire(std::string_view path)
+{
+	auto existing = texturesByPath.find(path);
+
+	if (existing != texturesByPath.end())
+	{
+		AddReference(existing->second);
+
+		return TextureHandle(this, existing->second);
+	}
+
+	size_t slot = entries.size();
+
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		entries.emplace_back();
+	}
+
+	entries[slot].path = path;
+	entries[slot].texture = LoadTexture(entries[slot].path.c_str());
+	entries[slot].referenceCount = 1;
+
+	texturesByPath.emplace(entries[slot].path, slot);
+
+	return TextureHandle(this, slot);
+}
+
+// Drops one reference to a texture and unloads it when it was the last one.
+void TextureCache::Release(size_t slot)
+{
+	Entry& entry = entries[slot];
+
+	if (--entry.referenceCount > 0)
+	{
+		return;
+	}
+
+	UnloadTexture(entry.texture);
+
+	texturesByPath.erase(entry.path);
+
+	entry.path.clear();
+	entry.texture = {};
+
+	freeSlots.push_back(slot);
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include <World/DenRegistry.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+
+// Sizes the grid the flow fields are laid over so it covers the area from the origin up to the given bounds.
+void DenRegistry::Initialize(float maxX, float maxY, float size)
+{
+	cellSize = std::max(size, 1.0f);
+
+	columns = std::max(1, static_cast<int>(maxX / cellSize) + 1);
+	rows = std::max(1, static_cast<int>(maxY / cellSize) + 1);
+
+	blocked.assign(static_cast<size_t>(columns * rows), 0);
+
+	for (Den& den : dens)
+	{
+		BuildFlowField(den);
+	}
+
+	dirty = false;
+}
+
+// Adds a den and builds its flow field straight away, returning the index wolves refer to it by.
+int DenRegistry::AddDen(Vector2 position)
+{
+	dens.push_back({ position, {}, {}, {} });
+
+	BuildFlowField(dens.back());
+
+	return static_cast<int>(dens.size()) - 1;
+}
+
+// Marks the cell containing the position as passable or not, deferring the rebuild of every field until it is next needed.
+void DenRegistry::SetBlocked(Vector2 position, bool isBlocked)
+{
+	uint8_t value = isBlocked ? 1 : 0;
+
+	int index = CellIndex(position);
+
+	if (blocked[index] != value)
+	{
+		blocked[index] = value;
+		dirty = true;
+	}
+}
+
+// Rebuilds every flow field if the terrain changed since they were last built.
+void DenRegistry::RebuildIfDirty()
+{
+	if (!dirty)
+	{
+		return;
+	}
+
+	for (Den& den : dens)
+	{
+		BuildFlowField(den);
+	}
+
+	dirty = false;
+}
+
+// Returns the direction a wolf at the position should move in to get home, heading straight for the den once it is next to it.
+Vector2 DenRegistry::GetDirectionHome(int denIndex, Vector2 position) const
+{
+	const Den& den = dens[denIndex];
+
+	int index = CellIndex(position);
+
+	if (den.cost[index] > 1.5f && den.cost[index] < std::numeric_limits<float>::max())
+	{
+		return { den.directionX[index], den.directionY[index] };
+	}
+
+	float dx = den.position.x - position.x;
+	float dy = den.position.y - position.y;
+	float distance = sqrtf(dx * dx + dy * dy);
+
+	if (distance <= 0.0f)
+	{
+		return { 0.0f, 0.0f };
+	}
+
+	return { dx / distance, dy / distance };
+}
+
+// Returns the index of the den closest to the position, or -1 if there are no dens.
+int DenRegistry::FindNearest(Vector2 position) const
+{
+	int nearest = -1;
+
+	float nearestDistanceSquared = std::numeric_limits<float>::max();
+
+	for (int i = 0; i < static_cast<int>(dens.size()); i++)
+	{
+		float dx = dens[i].position.x - position.x;
+		float dy = dens[i].position.y - position.y;
+		float distanceSquared = dx * dx + dy * dy;
+
+		if (distanceSquared < nearestDistanceSquared)
+		{
+			nearestDistanceSquared = distanceSquared;
+			nearest = i;
+		}
+	}
+
+	return nearest;
+}
+
+// Runs Dijkstra outwards from the den over the free cells, then points every reached cell at its cheapest neighbour.
+// Diagonal steps are only taken when both cells beside them are free, so paths never squeeze between blocked corners.
+void DenRegistry::BuildFlowField(Den& den)
+{
+	size_t cellCount = static_cast<size_t>(columns * rows);
+
+	den.cost.assign(cellCount, std::numeric_limits<float>::max());
+	den.directionX.assign(cellCount, 0.0f);
+	den.directionY.assign(cellCount, 0.0f);
+
+	static constexpr int offsetX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	static constexpr int offsetY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+	const float diagonalCost = sqrtf(2.0f);
+
+	auto isFree = [this](int cellX, int cellY)
+	{
+		return cellX >= 0 && cellX < columns && cellY >= 0 && cellY < rows && !blocked[cellY * columns + cellX];
+	};
+
+	auto canStep = [&isFree](int cellX, int cellY, int stepX, int stepY)
+	{
+		if (!isFree(cellX + stepX, cellY + stepY))
+		{
+			return false;
+		}
+
+		return stepX == 0 || stepY == 0 || (isFree(cellX + stepX, cellY) && isFree(cellX, cellY + stepY));
+	};
+
+	int denIndex = CellIndex(den.position);
+
+	using QueueEntry = std::pair<float, int>;
+
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> frontier;
+
+	den.cost[denIndex] = 0.0f;
+	frontier.push({ 0.0f, denIndex });
+
+	while (!frontier.empty())
+	{
+		auto [cost, index] = frontier.top();
+		frontier.pop();
+
+		if (cost > den.cost[index])
+		{
+			continue;
+		}
+
+		int cellX = index % columns;
+		int cellY = index / columns;
+
+		for (int i = 0; i < 8; i++)
+		{
+			if (!canStep(cellX, cellY, offsetX[i], offsetY[i]))
+			{
+				continue;
+			}
+
+			int neighborIndex = (cellY + offsetY[i]) * columns + cellX + offsetX[i];
+
+			float neighborCost = cost + (i < 4 ? 1.0f : diagonalCost);
+
+			if (neighborCost < den.cost[neighborIndex])
+			{
+				den.cost[neighborIndex] = neighborCost;
+				frontier.push({ neighborCost, neighborIndex });
+			}
+		}
+	}
+
+	for (int cellY = 0; cellY < rows; cellY++)
+	{
+		for (int cellX = 0; cellX < columns; cellX++)
+		{
+			int index = cellY * columns + cellX;
+
+			float bestCost = den.cost[index];
+			int bestStep = -1;
+
+			for (int i = 0; i < 8; i++)
+			{
+				if (!canStep(cellX, cellY, offsetX[i], offsetY[i]))
+				{
+					continue;
+				}
+
+				float neighborCost = den.cost[(cellY + offsetY[i]) * columns + cellX + offsetX[i]];
+
+				if (neighborCost < bestCost)
+				{
+					bestCost = neighborCost;
+					bestStep = i;
+				}
+			}
+
+			if (bestStep >= 0)
+			{
+				float length = (bestStep < 4) ? 1.0f : diagonalCost;
+
+				den.directionX[index] = offsetX[bestStep] / length;
+				den.directionY[index] = offsetY[bestStep] / length;
+			}
+		}
+	}
+}
+
+// Returns the index of the grid cell containing the position, clamped to the grid.
+int DenRegistry::CellIndex(Vector2 position) const
+{
+	int cellX = std::clamp(static_cast<int>(position.x / cellSize), 0, columns - 1);
+	int cellY = std::clamp(static_cast<int>(position.y / cellSize), 0, rows - 1);
+
+	return cellY * columns + cellX;
+}
\ No newline at end of file
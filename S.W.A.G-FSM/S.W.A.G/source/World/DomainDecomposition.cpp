@@ -0,0 +1,103 @@
+#include <World/DomainDecomposition.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+// Lays the columns over the area from the origin up to maxX the same way the spatial grids do, then splits them evenly into as many strips as fit.
+void DomainDecomposition::Initialize(float maxX, float width, int domainCount, float minDomainWidth)
+{
+	columnWidth = std::max(width, 1.0f);
+
+	columns = std::max(1, static_cast<int>(maxX / columnWidth) + 1);
+	minColumns = std::max(1, static_cast<int>(ceilf(minDomainWidth / columnWidth)));
+
+	int count = std::clamp(domainCount, 1, std::max(1, columns / minColumns));
+
+	edges.resize(static_cast<size_t>(count) + 1);
+
+	for (int i = 0; i <= count; i++)
+	{
+		edges[i] = i * columns / count;
+	}
+}
+
+// Counts the entities per column and, when the busiest strip holds more than its share by the tolerance, moves every edge to where the share is reached.
+// Each strip keeps at least the minimum width, so it never becomes too narrow for entities to fit inside it.
+void DomainDecomposition::Rebalance(const std::vector<float>& positionsX, float tolerance)
+{
+	int count = GetDomainCount();
+
+	if (count < 2 || positionsX.empty())
+	{
+		return;
+	}
+
+	loadBefore.assign(static_cast<size_t>(columns) + 1, 0);
+
+	for (float x : positionsX)
+	{
+		loadBefore[ColumnOf(x) + 1]++;
+	}
+
+	for (int column = 0; column < columns; column++)
+	{
+		loadBefore[column + 1] += loadBefore[column];
+	}
+
+	float share = static_cast<float>(positionsX.size()) / count;
+
+	int heaviest = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		heaviest = std::max(heaviest, loadBefore[edges[i + 1]] - loadBefore[edges[i]]);
+	}
+
+	if (heaviest <= share * (1.0f + tolerance))
+	{
+		return;
+	}
+
+	for (int i = 1; i < count; i++)
+	{
+		int lowest = edges[i - 1] + minColumns;
+		int highest = columns - (count - i) * minColumns;
+
+		float target = share * i;
+
+		int edge = lowest;
+
+		while (edge < highest && loadBefore[edge] < target)
+		{
+			edge++;
+		}
+
+		// Stop one column short when that lands closer to the share.
+		if (edge > lowest && target - loadBefore[edge - 1] < loadBefore[edge] - target)
+		{
+			edge--;
+		}
+
+		edges[i] = edge;
+	}
+}
+
+// Returns the strip that contains the whole span from minX to maxX, or Boundary when the span crosses an edge. Positions beyond the world count towards the outer strips, as in the grids.
+int DomainDecomposition::FindDomain(float minX, float maxX) const
+{
+	auto stripOf = [this](float x)
+	{
+		return static_cast<int>(std::upper_bound(edges.begin() + 1, edges.end() - 1, ColumnOf(x)) - edges.begin()) - 1;
+	};
+
+	int domain = stripOf(minX);
+
+	return domain == stripOf(maxX) ? domain : Boundary;
+}
+
+// Returns the column containing the x coordinate, clamped to the columns.
+int DomainDecomposition::ColumnOf(float x) const
+{
+	return std::clamp(static_cast<int>(floorf(x / columnWidth)), 0, columns - 1);
+}
\ No newline at end of file
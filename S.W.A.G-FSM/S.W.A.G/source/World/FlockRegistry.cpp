@@ -0,0 +1,362 @@
+#include <Entities/Sheep/SheepStateMachine.h>
+#include <Utility/SimulationConfig.h>
+#include <Utility/CoordinateUtils.h>
+#include <World/FlockRegistry.h>
+#include <World/World.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+// Returns the push away from crowding flock mates computed for a member during the last update.
+Vector2 Flock::GetSeparation(SheepHandle member) const
+{
+	for (int i = 0; i < count; i++)
+	{
+		if (members[i] == member)
+		{
+			return separation[i];
+		}
+	}
+
+	return { 0.0f, 0.0f };
+}
+
+// Starts a new flock led by the given sheep, reusing the slot of a dissolved flock when there is one.
+int32_t FlockRegistry::Create(SheepStateMachine* leader, SheepStateMachine* follower)
+{
+	Leave(leader);
+	Leave(follower);
+
+	int32_t flockId;
+
+	if (!freeFlocks.empty())
+	{
+		flockId = freeFlocks.back();
+		freeFlocks.pop_back();
+	}
+	else
+	{
+		flockId = static_cast<int32_t>(flocks.size());
+		flocks.emplace_back();
+	}
+
+	Flock& flock = flocks[flockId];
+
+	flock = Flock{};
+	flock.members[0] = leader->GetHandle();
+	flock.members[1] = follower->GetHandle();
+	flock.count = 2;
+	flock.active = true;
+
+	SetGroupId(leader, flockId);
+	SetGroupId(follower, flockId);
+
+	return flockId;
+}
+
+// Adds a sheep to the back of a flock, failing when the flock is gone or already at the configured size.
+bool FlockRegistry::Join(int32_t flockId, SheepStateMachine* sheep)
+{
+	if (!Get(flockId))
+	{
+		return false;
+	}
+
+	if (sheep->GetGroupId() == flockId)
+	{
+		return true;
+	}
+
+	Flock& flock = flocks[flockId];
+
+	int maxSize = std::min(static_cast<int>(RuntimeConfig::SheepMaxGroupSize()), ValueConfig::Sheep::FlockCapacity);
+
+	if (flock.count >= maxSize)
+	{
+		return false;
+	}
+
+	Leave(sheep);
+
+	flock.members[flock.count] = sheep->GetHandle();
+	flock.separation[flock.count] = { 0.0f, 0.0f };
+	flock.count++;
+
+	// The new member may stand outside the area the last pass covered, so members query on their own until the next one.
+	flock.perception.valid = false;
+	flock.perceptionTimer = ValueConfig::Sheep::PerceptionInterval;
+
+	SetGroupId(sheep, flockId);
+
+	return true;
+}
+
+// Takes a sheep out of its flock. A departing leader hands the flock to the next member, and a flock left with one sheep dissolves.
+void FlockRegistry::Leave(SheepStateMachine* sheep)
+{
+	int32_t flockId = sheep->GetGroupId();
+
+	SetGroupId(sheep, SheepStore::NoGroup);
+
+	if (!Get(flockId))
+	{
+		return;
+	}
+
+	// Matched by handle, since a dead sheep is still recognised by the handle it had even though it no longer resolves.
+	Flock& flock = flocks[flockId];
+
+	for (int i = 0; i < flock.count; i++)
+	{
+		if (flock.members[i] == sheep->GetHandle())
+		{
+			RemoveMember(flockId, i);
+			return;
+		}
+	}
+}
+
+// Splits off stragglers, then refreshes the centroid, member separation, reproduction readiness and shared perception of every flock.
+void FlockRegistry::Update(float deltaTime)
+{
+	float leaveDistance = RuntimeConfig::SheepGroupRadius() * 1.5f;
+	float minGroupDistance = ValueConfig::Sheep::MinGroupDistance;
+	float healthyThreshold = RuntimeConfig::SheepMaxHealth() * 0.5f;
+
+	for (int32_t flockId = 0; flockId < static_cast<int32_t>(flocks.size()); flockId++)
+	{
+		Flock& flock = flocks[flockId];
+
+		if (!flock.active)
+		{
+			continue;
+		}
+
+		SheepStateMachine* leader = world->GetSheep(flock.GetLeader());
+
+		if (!leader)
+		{
+			RemoveMember(flockId, 0);
+			continue;
+		}
+
+		Vector2 leaderPosition = leader->GetPosition();
+
+		bool leaderWandering = leader->GetCurrentState() == SheepActivity::WanderingInGroup;
+
+		for (int i = flock.count - 1; i >= 1 && flock.active; i--)
+		{
+			SheepStateMachine* member = world->GetSheep(flock.members[i]);
+
+			if (!member)
+			{
+				RemoveMember(flockId, i);
+				continue;
+			}
+
+			Vector2 memberPosition = member->GetPosition();
+
+			float dx = leaderPosition.x - memberPosition.x;
+			float dy = leaderPosition.y - memberPosition.y;
+
+			bool memberWandering = member->GetCurrentState() == SheepActivity::WanderingInGroup;
+
+			if ((leaderWandering || memberWandering) && dx * dx + dy * dy > leaveDistance * leaveDistance)
+			{
+				SetGroupId(member, SheepStore::NoGroup);
+				RemoveMember(flockId, i);
+			}
+		}
+
+		if (!flock.active)
+		{
+			continue;
+		}
+
+		std::array<Vector2, ValueConfig::Sheep::FlockCapacity> positions;
+
+		Vector2 positionSum = { 0.0f, 0.0f };
+
+		bool hasHealthyFollower = false;
+
+		for (int i = 0; i < flock.count; i++)
+		{
+			SheepStateMachine* member = world->GetSheep(flock.members[i]);
+
+			positions[i] = member->GetPosition();
+			positionSum.x += positions[i].x;
+			positionSum.y += positions[i].y;
+
+			flock.separation[i] = { 0.0f, 0.0f };
+
+			if (i > 0 && member->GetHealth() > healthyThreshold)
+			{
+				hasHealthyFollower = true;
+			}
+		}
+
+		flock.centroid = { positionSum.x / flock.count, positionSum.y / flock.count };
+		flock.radius = 0.0f;
+
+		for (int i = 0; i < flock.count; i++)
+		{
+			float dx = positions[i].x - flock.centroid.x;
+			float dy = positions[i].y - flock.centroid.y;
+
+			flock.radius = std::max(flock.radius, sqrtf(dx * dx + dy * dy));
+		}
+
+		// The leader keeps its own distance from the followers, so separation only pushes followers apart from each other.
+		for (int i = 1; i < flock.count; i++)
+		{
+			for (int j = i + 1; j < flock.count; j++)
+			{
+				float dx = positions[i].x - positions[j].x;
+				float dy = positions[i].y - positions[j].y;
+				float distance = sqrtf(dx * dx + dy * dy);
+
+				if (distance < minGroupDistance && distance > 0.0f)
+				{
+					Vector2 away = { dx / distance, dy / distance };
+
+					flock.separation[i].x += away.x;
+					flock.separation[i].y += away.y;
+					flock.separation[j].x -= away.x;
+					flock.separation[j].y -= away.y;
+				}
+			}
+		}
+
+		if (leaderWandering)
+		{
+			flock.reproductionTimer += deltaTime;
+		}
+
+		flock.readyToReproduce = leaderWandering && flock.reproductionTimer >= ValueConfig::Sheep::ReproductionInterval && leader->GetHealth() > healthyThreshold && hasHealthyFollower;
+
+		flock.perceptionTimer += deltaTime;
+
+		if (!RuntimeConfig::SheepSharedFlockPerception())
+		{
+			flock.perception.valid = false;
+		}
+		else if (flock.perceptionTimer >= ValueConfig::Sheep::PerceptionInterval)
+		{
+			Perceive(flock);
+			flock.perceptionTimer = 0.0f;
+		}
+	}
+}
+
+// Runs one wolf and one grass query for the whole flock, wide enough that every member's own detection radius lies inside it.
+void FlockRegistry::Perceive(Flock& flock)
+{
+	FlockPerception& perception = flock.perception;
+
+	perception.wolfCount = 0;
+	perception.grassCount = 0;
+	perception.valid = true;
+
+	float inflation = flock.radius + ValueConfig::Sheep::PerceptionMargin;
+
+	world->GetWolfGrid().QueryRadius(flock.centroid, RuntimeConfig::SheepWolfDetectionRadius() + inflation, [&perception](WolfStateMachine* wolf)
+	{
+		if (perception.wolfCount == ValueConfig::Sheep::PerceptionCapacity)
+		{
+			perception.valid = false;
+			return;
+		}
+
+		perception.wolves[perception.wolfCount++] = wolf->GetHandle();
+	});
+
+	// Droppings do not depend on who is looking, so contaminated grass is filtered out here once for all members.
+	world->GetEdibleGrassGrid().QueryRadius(flock.centroid, RuntimeConfig::SheepGrassDetectionRadius() + inflation, [this, &perception](GrassStateMachine* grass)
+	{
+		Vector2 grassPosition = CoordinateUtils::GridToWorldPosition(grass->GetPosition(), world->GetCellSize());
+
+		if (world->IsSheepPoopNearby(grassPosition))
+		{
+			return;
+		}
+
+		if (perception.grassCount == ValueConfig::Sheep::PerceptionCapacity)
+		{
+			perception.valid = false;
+			return;
+		}
+
+		perception.grass[perception.grassCount] = grass->GetHandle();
+		perception.grassPositions[perception.grassCount] = grassPosition;
+		perception.grassCount++;
+	});
+}
+
+// Restarts the reproduction countdown of a flock once its leader has acted on it.
+void FlockRegistry::ResetReproductionTimer(int32_t flockId)
+{
+	if (!Get(flockId))
+	{
+		return;
+	}
+
+	flocks[flockId].reproductionTimer = 0.0f;
+	flocks[flockId].readyToReproduce = false;
+}
+
+// Returns the flock with the given id, or null if there is none.
+const Flock* FlockRegistry::Get(int32_t flockId) const
+{
+	if (flockId < 0 || flockId >= static_cast<int32_t>(flocks.size()) || !flocks[flockId].active)
+	{
+		return nullptr;
+	}
+
+	return &flocks[flockId];
+}
+
+// Closes the gap left by a member so the remaining ones keep their joining order, dissolving the flock once it is down to one sheep.
+void FlockRegistry::RemoveMember(int32_t flockId, int index)
+{
+	Flock& flock = flocks[flockId];
+
+	for (int i = index; i < flock.count - 1; i++)
+	{
+		flock.members[i] = flock.members[i + 1];
+		flock.separation[i] = flock.separation[i + 1];
+	}
+
+	flock.count--;
+
+	if (flock.count < 2)
+	{
+		Dissolve(flockId);
+	}
+}
+
+// Releases every remaining member of a flock and hands its slot back to the world to be reused.
+void FlockRegistry::Dissolve(int32_t flockId)
+{
+	Flock& flock = flocks[flockId];
+
+	for (int i = 0; i < flock.count; i++)
+	{
+		if (SheepStateMachine* member = world->GetSheep(flock.members[i]))
+		{
+			SetGroupId(member, SheepStore::NoGroup);
+		}
+	}
+
+	flock.count = 0;
+	flock.active = false;
+	flock.readyToReproduce = false;
+
+	world->ReleaseFlock(flockId);
+}
+
+// Records a sheep's flock in the sheep store.
+void FlockRegistry::SetGroupId(SheepStateMachine* sheep, int32_t flockId)
+{
+	world->GetSheepStore().SetGroupId(sheep->GetStoreSlot(), flockId);
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <World/ParticleSystem.h>
+#include <World/RenderSnapshot.h>
+
+#include <algorithm>
+
+
+// Allocates every particle array once, so spawning never touches the heap.
+ParticleSystem::ParticleSystem(size_t capacity, float lifetime) : lifetime(lifetime)
+{
+	capacity = std::max<size_t>(capacity, 1);
+
+	positionX.resize(capacity);
+	positionY.resize(capacity);
+	radius.resize(capacity);
+	spawnTime.resize(capacity);
+	color.resize(capacity);
+}
+
+// Writes a particle behind the newest one, overwriting the oldest particle when the buffer is full.
+void ParticleSystem::Spawn(Vector2 position, float particleRadius, Color particleColor)
+{
+	if (count == GetCapacity())
+	{
+		head = Wrap(head + 1);
+		count--;
+	}
+
+	size_t index = Wrap(head + count);
+
+	positionX[index] = position.x;
+	positionY[index] = position.y;
+	radius[index] = particleRadius;
+	spawnTime[index] = elapsedTime;
+	color[index] = particleColor;
+
+	count++;
+}
+
+// Advances the particle clock and drops every expired particle by moving the head past it.
+void ParticleSystem::Update(float deltaTime)
+{
+	elapsedTime += deltaTime;
+
+	while (count > 0 && elapsedTime - spawnTime[head] >= lifetime)
+	{
+		head = Wrap(head + 1);
+		count--;
+	}
+}
+
+// Appends every live particle to the snapshot, with its color already faded out over its lifetime.
+void ParticleSystem::WriteSnapshot(std::vector<ParticleSnapshot>& particles) const
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		size_t index = Wrap(head + i);
+
+		float alpha = 1.0f - (elapsedTime - spawnTime[index]) / lifetime;
+
+		Color fadedColor = color[index];
+		fadedColor.a = static_cast<unsigned char>(fadedColor.a * alpha);
+
+		particles.push_back({ { positionX[index], positionY[index] }, radius[index], fadedColor });
+	}
+}
\ No newline at end of file
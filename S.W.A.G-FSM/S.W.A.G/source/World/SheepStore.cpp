@@ -0,0 +1,82 @@
+#include <Entities/Sheep/SheepStateMachine.h>
+#include <World/SheepStore.h>
+
+#include <algorithm>
+
+
+// Appends a new sheep at the end of every array and returns the slot it was given.
+size_t SheepStore::Add(SheepStateMachine* owner, Vector2 position, float initialHealth)
+{
+	owners.push_back(owner);
+	activity.push_back(SheepActivity::WanderingAlone);
+	groupId.push_back(NoGroup);
+
+	positionX.push_back(position.x);
+	positionY.push_back(position.y);
+	velocityX.push_back(0.0f);
+	velocityY.push_back(0.0f);
+	health.push_back(initialHealth);
+	hunger.push_back(0.0f);
+	fullness.push_back(0.0f);
+
+	return owners.size() - 1;
+}
+
+// Removes a sheep by moving the last sheep into its slot, keeping the arrays free of gaps.
+void SheepStore::Remove(size_t slot)
+{
+	size_t last = owners.size() - 1;
+
+	if (slot != last)
+	{
+		owners[slot] = owners[last];
+		activity[slot] = activity[last];
+		groupId[slot] = groupId[last];
+
+		positionX[slot] = positionX[last];
+		positionY[slot] = positionY[last];
+		velocityX[slot] = velocityX[last];
+		velocityY[slot] = velocityY[last];
+		health[slot] = health[last];
+		hunger[slot] = hunger[last];
+		fullness[slot] = fullness[last];
+
+		owners[slot]->SetStoreSlot(slot);
+	}
+
+	owners.pop_back();
+	activity.pop_back();
+	groupId.pop_back();
+
+	positionX.pop_back();
+	positionY.pop_back();
+	velocityX.pop_back();
+	velocityY.pop_back();
+	health.pop_back();
+	hunger.pop_back();
+	fullness.pop_back();
+}
+
+// Moves every sheep by the velocity its state asked for, clamps it to the bounds and clears the velocity for the next tick.
+// The loop only touches flat float arrays with no branches, so the compiler is free to vectorize it.
+void SheepStore::Integrate(float deltaTime, const MovementBounds& bounds)
+{
+	previousPositionX.assign(positionX.begin(), positionX.end());
+	previousPositionY.assign(positionY.begin(), positionY.end());
+
+	size_t count = positionX.size();
+
+	float* x = positionX.data();
+	float* y = positionY.data();
+	float* vx = velocityX.data();
+	float* vy = velocityY.data();
+
+	for (size_t i = 0; i < count; i++)
+	{
+		x[i] = std::max(bounds.minX, std::min(x[i] + vx[i] * deltaTime, bounds.maxX));
+		y[i] = std::max(bounds.minY, std::min(y[i] + vy[i] * deltaTime, bounds.maxY));
+
+		vx[i] = 0.0f;
+		vy[i] = 0.0f;
+	}
+}
\ No newline at end of file
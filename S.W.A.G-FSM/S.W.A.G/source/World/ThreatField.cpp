@@ -0,0 +1,155 @@
+#include <World/ThreatField.h>
+
+#include <limits>
+
+
+// Sizes the grid to cover the area from the origin up to the given bounds and bakes the edge avoidance of every cell.
+void ThreatField::Initialize(float maxX, float maxY, float size, Vector2 edgeBounds, float edgeMargin)
+{
+	cellSize = std::max(size, 1.0f);
+
+	columns = std::max(1, static_cast<int>(maxX / cellSize) + 1);
+	rows = std::max(1, static_cast<int>(maxY / cellSize) + 1);
+
+	size_t cellCount = static_cast<size_t>(columns * rows);
+
+	nearestWolf.assign(cellCount, -1);
+	nearestDistanceSquared.assign(cellCount, std::numeric_limits<float>::max());
+	edgeAvoidanceX.assign(cellCount, 0.0f);
+	edgeAvoidanceY.assign(cellCount, 0.0f);
+
+	for (int cellY = 0; cellY < rows; cellY++)
+	{
+		for (int cellX = 0; cellX < columns; cellX++)
+		{
+			Vector2 center = CellCenter(cellX, cellY);
+
+			int index = CellIndex(cellX, cellY);
+
+			if (center.x < edgeMargin)
+			{
+				edgeAvoidanceX[index] = 1.0f - (center.x / edgeMargin);
+			}
+			else if (center.x > edgeBounds.x - edgeMargin)
+			{
+				edgeAvoidanceX[index] = -1.0f * (1.0f - ((edgeBounds.x - center.x) / edgeMargin));
+			}
+
+			if (center.y < edgeMargin)
+			{
+				edgeAvoidanceY[index] = 1.0f - (center.y / edgeMargin);
+			}
+			else if (center.y > edgeBounds.y - edgeMargin)
+			{
+				edgeAvoidanceY[index] = -1.0f * (1.0f - ((edgeBounds.y - center.y) / edgeMargin));
+			}
+		}
+	}
+}
+
+// Forgets every wolf so the field can be rebuilt from the current positions.
+void ThreatField::Clear()
+{
+	wolves.clear();
+
+	std::fill(nearestWolf.begin(), nearestWolf.end(), -1);
+	std::fill(nearestDistanceSquared.begin(), nearestDistanceSquared.end(), std::numeric_limits<float>::max());
+}
+
+// Seeds the field with a wolf in the cell it stands in.
+void ThreatField::AddWolf(Vector2 position)
+{
+	int cellX = CellX(position.x);
+	int cellY = CellY(position.y);
+	int index = CellIndex(cellX, cellY);
+
+	Vector2 center = CellCenter(cellX, cellY);
+
+	float dx = center.x - position.x;
+	float dy = center.y - position.y;
+	float distanceSquared = dx * dx + dy * dy;
+
+	wolves.push_back(position);
+
+	if (distanceSquared < nearestDistanceSquared[index])
+	{
+		nearestWolf[index] = static_cast<int32_t>(wolves.size() - 1);
+		nearestDistanceSquared[index] = distanceSquared;
+	}
+}
+
+// Spreads the seeded wolves over the whole grid with one forward and one backward sweep, in the manner of a two-pass distance transform.
+// Each cell adopts a neighbour's wolf whenever that wolf is nearer to the cell's centre than the one it already has.
+void ThreatField::Propagate()
+{
+	if (wolves.empty())
+	{
+		return;
+	}
+
+	for (int cellY = 0; cellY < rows; cellY++)
+	{
+		for (int cellX = 0; cellX < columns; cellX++)
+		{
+			TakeNearerWolf(cellX, cellY, cellX - 1, cellY);
+			TakeNearerWolf(cellX, cellY, cellX - 1, cellY - 1);
+			TakeNearerWolf(cellX, cellY, cellX, cellY - 1);
+			TakeNearerWolf(cellX, cellY, cellX + 1, cellY - 1);
+		}
+	}
+
+	for (int cellY = rows - 1; cellY >= 0; cellY--)
+	{
+		for (int cellX = columns - 1; cellX >= 0; cellX--)
+		{
+			TakeNearerWolf(cellX, cellY, cellX + 1, cellY);
+			TakeNearerWolf(cellX, cellY, cellX + 1, cellY + 1);
+			TakeNearerWolf(cellX, cellY, cellX, cellY + 1);
+			TakeNearerWolf(cellX, cellY, cellX - 1, cellY + 1);
+		}
+	}
+}
+
+// Returns the wolf nearest to the cell containing the position, if there is any wolf at all, along with that cell's edge avoidance.
+ThreatField::Threat ThreatField::Sample(Vector2 position) const
+{
+	int index = CellIndex(CellX(position.x), CellY(position.y));
+
+	Threat threat;
+
+	threat.edgeAvoidance = { edgeAvoidanceX[index], edgeAvoidanceY[index] };
+	threat.hasWolf = nearestWolf[index] >= 0;
+	threat.wolfPosition = threat.hasWolf ? wolves[nearestWolf[index]] : Vector2{ 0.0f, 0.0f };
+
+	return threat;
+}
+
+// Makes a cell adopt the wolf of one of its neighbours if that wolf is nearer to the cell's centre.
+void ThreatField::TakeNearerWolf(int cellX, int cellY, int neighborX, int neighborY)
+{
+	if (neighborX < 0 || neighborX >= columns || neighborY < 0 || neighborY >= rows)
+	{
+		return;
+	}
+
+	int32_t candidate = nearestWolf[CellIndex(neighborX, neighborY)];
+
+	if (candidate < 0)
+	{
+		return;
+	}
+
+	int index = CellIndex(cellX, cellY);
+
+	Vector2 center = CellCenter(cellX, cellY);
+
+	float dx = center.x - wolves[candidate].x;
+	float dy = center.y - wolves[candidate].y;
+	float distanceSquared = dx * dx + dy * dy;
+
+	if (distanceSquared < nearestDistanceSquared[index])
+	{
+		nearestWolf[index] = candidate;
+		nearestDistanceSquared[index] = distanceSquared;
+	}
+}
\ No newline at end of file
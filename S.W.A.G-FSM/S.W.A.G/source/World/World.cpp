@@ -3,19 +3,54 @@
 #include <Entities/Sheep/SheepStateMachine.h>
 #include <Entities/Wolf/WolfStateMachine.h>
 #include <Utility/SimulationConfig.h>
+#include <Utility/CoordinateUtils.h>
 #include <Utility/ValueConfig.h>
 #include <World/World.h>
 
+#include <algorithm>
 
-// Creates a new world with specified dimensions and cell size.
-World::World(int width, int height, float cellSize, float viewportYOffset, float scaleFactor, Simulation* simulation) : width(width), height(height), cellSize(cellSize* scaleFactor), minY(viewportYOffset), scaleFactor(scaleFactor), simulation(simulation)
+
+// Creates a new world of the given number of cells, measured in world units and independent of the window it is shown in.
+World::World(int width, int height, float cellSize, Simulation* simulation) : width(width), height(height), cellSize(cellSize), simulation(simulation), poopParticles(ValueConfig::World::PoopParticleCapacity, ValueConfig::World::PoopLifetime), bloodParticles(ValueConfig::World::BloodParticleCapacity, ValueConfig::World::BloodSplatterLifetime), flockRegistry(this), jobs(RuntimeConfig::WorldWorkerThreadCount() < 0 ? JobSystem::DefaultWorkerCount() : static_cast<unsigned int>(RuntimeConfig::WorldWorkerThreadCount()))
 {
+	grassCells.assign(static_cast<size_t>(std::max(0, width * height)), nullptr);
+	poopContaminationExpiry.assign(static_cast<size_t>(std::max(0, width * height)), 0.0f);
+
+	sheepGrid.Initialize(GetMaxX(), GetMaxY(), ValueConfig::World::SpatialBucketSize);
+	wolfGrid.Initialize(GetMaxX(), GetMaxY(), ValueConfig::World::SpatialBucketSize);
+	edibleGrassGrid.Initialize(GetMaxX(), GetMaxY(), ValueConfig::World::SpatialBucketSize);
+
+	threatField.Initialize(GetMaxX(), GetMaxY(), cellSize, { GetMaxX(), GetMaxY() }, ValueConfig::Sheep::EdgeAvoidanceMargin);
+	dens.Initialize(GetMaxX(), GetMaxY(), cellSize);
+
+	// Sheep and wolves share a size, so one set of bounds keeps both inside the world.
+	float entitySize = cellSize;
+	float edgeMargin = ValueConfig::World::EdgeMargin;
+
+	movementBounds.minX = 0.0f;
+	movementBounds.minY = 0.0f;
+	movementBounds.maxX = std::max(0.0f, GetMaxX() - entitySize - edgeMargin);
+	movementBounds.maxY = std::max(0.0f, GetMaxY() - entitySize - edgeMargin);
+
+	// One buffer for the calling thread and one for each worker.
+	commandBuffers.resize(jobs.GetThreadCount());
+
+	// Strips are at least wide enough that a sheep with its halo on both sides still fits inside one.
+	float halo = GetDomainHalo();
+
+	domains.Initialize(GetMaxX(), ValueConfig::World::SpatialBucketSize, ValueConfig::World::DomainCount, 2.0f * halo + ValueConfig::World::SpatialBucketSize);
+	domainWork.resize(domains.GetDomainCount());
+
+	BuildUpdatePhases();
 }
 
+thread_local World::DomainWork* World::activeDomain = nullptr;
+
+
 // Initializes the world with a specified number entities.
 void World::Initialize(int grassCount, int sheepCount, int wolfCount)
 {
-	float minimumY = GetMinY();
+	grassCount = std::min(grassCount, width * height);
 
 	// Initialize grass
 	for (int i = 0; i < grassCount; i++)
@@ -27,110 +62,280 @@ void World::Initialize(int grassCount, int sheepCount, int wolfCount)
 			position.x = static_cast<float>(GetRandomValue(0, width - 1));
 			position.y = static_cast<float>(GetRandomValue(0, height - 1));
 
-			if (position.y * cellSize * scaleFactor + minY < minimumY)
-			{
-				position.y = minimumY / (cellSize * scaleFactor);
-			}
-
 		} while (IsCellOccupied(position));
 
 		CreateGrass(position);
 	}
 
-	// Create wolf at its den.
-	Vector2 wolfPosition;
-	wolfPosition.x = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - ValueConfig::World::CellSize * scaleFactor * 2);
-	wolfPosition.y = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f) / 2;
-
-	float maxX = static_cast<float>(GetScreenWidth()) * 3.0f / 4.0f - ValueConfig::World::CellSize * scaleFactor;
-	float maxY = static_cast<float>(GetScreenHeight()) * 2.0f / 3.0f - ValueConfig::World::CellSize * scaleFactor;
-
-	wolfPosition.x = std::max(0.0f, std::min(wolfPosition.x, maxX));
-	wolfPosition.y = std::max(minimumY, std::min(wolfPosition.y, maxY));
+	// Create the den and its wolves.
+	Vector2 denPosition = movementBounds.Clamp({ GetMaxX() - cellSize * 2, GetMaxY() / 2 });
 
+	int den = dens.AddDen(denPosition);
 
 	for (int i = 0; i < wolfCount; i++)
 	{
-		CreateWolf(wolfPosition);
+		CreateWolf(dens.GetPosition(den));
 	}
 
 	// Create initial sheep at random positions.
 	for (int i = 0; i < sheepCount; i++)
 	{
-		Vector2 sheepPosition;
+		Vector2 sheepCell;
 
 		do
 		{
-			sheepPosition.x = static_cast<float>(GetRandomValue(0, width - 1)) * cellSize * scaleFactor;
-			sheepPosition.y = static_cast<float>(GetRandomValue(0, height - 1)) * cellSize * scaleFactor;
+			sheepCell.x = static_cast<float>(GetRandomValue(0, width - 1));
+			sheepCell.y = static_cast<float>(GetRandomValue(0, height - 1));
 
-		} while (IsCellOccupied(sheepPosition));
+		} while (IsCellOccupied(sheepCell));
 
-		CreateSheep(sheepPosition);
+		CreateSheep(CoordinateUtils::GridToWorldPosition(sheepCell, cellSize));
 	}
 }
 
-// Updates all grass entities and processes pending grass creation.
+// Advances the world by one tick, running the update phases as jobs in the order their dependencies allow.
 void World::Update(float deltaTime)
 {
-	// Update sheep poop instances.
-	UpdateSheepPoop(deltaTime);
+	simulationTime += deltaTime;
+	tickDeltaTime = deltaTime;
+
+	updatePhases.Run(jobs);
+}
+
+// Declares the phases of a tick and what each has to wait for. Phases touching disjoint data are left free to overlap.
+// Grass, wolves, sheep and the final commit all draw from raylib's shared random numbers, so they form one chain and the sequence stays the same on every run.
+void World::BuildUpdatePhases()
+{
+	using PhaseId = PhaseGraph::PhaseId;
+
+	PhaseId rebuildDens = updatePhases.AddPhase([this]() { dens.RebuildIfDirty(); });
+	PhaseId decayPoop = updatePhases.AddPhase([this]() { poopParticles.Update(tickDeltaTime); });
+	PhaseId decayBlood = updatePhases.AddPhase([this]() { bloodParticles.Update(tickDeltaTime); });
+	PhaseId updateGrass = updatePhases.AddPhase([this]() { UpdateGrass(tickDeltaTime); });
+
+	// Everything entities perceive this tick is read before anything changes, so the world as the last tick left it is the snapshot.
+	PhaseId perceive = updatePhases.AddPhase([this]() { PerceiveEntities(tickDeltaTime); });
+	PhaseId sheepVitals = updatePhases.AddPhase([this]() { UpdateSheepVitals(tickDeltaTime); }, { perceive });
+
+	PhaseId updateWolves = updatePhases.AddPhase([this]() { UpdateWolves(tickDeltaTime); }, { rebuildDens, updateGrass, sheepVitals });
+	PhaseId moveWolves = updatePhases.AddPhase([this]() { IntegrateWolfMovement(tickDeltaTime); }, { updateWolves });
 
-	// Update blood splatter instances.
-	UpdateBloodSplatters(deltaTime);
+	// Fleeing sheep read the threat field instead of searching for wolves, and flock-wide bookkeeping runs once per group before its members act on it.
+	PhaseId rebuildThreats = updatePhases.AddPhase([this]() { RebuildThreatField(); }, { moveWolves });
+	PhaseId updateFlocks = updatePhases.AddPhase([this]() { flockRegistry.Update(tickDeltaTime); }, { moveWolves });
 
-	// Update and remove dead grass.
-	for (auto it = grasses.begin(); it != grasses.end();)
+	PhaseId updateSheep = updatePhases.AddPhase([this]() { UpdateSheep(tickDeltaTime); }, { rebuildThreats, updateFlocks });
+
+	updatePhases.AddPhase([this]() { CommitTick(tickDeltaTime); }, { updateSheep, decayPoop, decayBlood });
+}
+
+// Updates the living grass one by one, since growing and dying grass changes the shared grass index and cell table.
+void World::UpdateGrass(float deltaTime)
+{
+	CommandBuffer& commands = GetCommandBuffer();
+
+	for (size_t i = 0; i < grasses.size(); i++)
 	{
-		if (!(*it)->IsAlive())
+		if (grasses[i]->IsAlive())
 		{
-			it = grasses.erase(it);
+			commands.SetIssuer(CommandIssuer(CommandPhase::Grass, i));
+			grasses[i]->Entity::Update(deltaTime);
 		}
-		else
+	}
+}
+
+// Updates the living wolves. Dead ones, like every other dead entity, are handled together once every entity had its turn.
+void World::UpdateWolves(float deltaTime)
+{
+	CommandBuffer& commands = GetCommandBuffer();
+
+	for (size_t i = 0; i < wolves.size(); i++)
+	{
+		if (wolves[i]->IsAlive())
 		{
-			(*it)->Entity::Update(deltaTime);
-			++it;
+			commands.SetIssuer(CommandIssuer(CommandPhase::Wolves, i));
+			wolves[i]->Entity::Update(deltaTime);
 		}
 	}
+}
 
-	// Update wolves
-	for (auto it = wolves.begin(); it != wolves.end();)
+// Updates the living sheep, one domain per worker thread when decomposition is on, then the sheep on the domain boundaries one at a time.
+// A domain only holds sheep whose flock and halo lie inside its strip, so no two domains reach the same grid bucket, flock or grass.
+void World::UpdateSheep(float deltaTime)
+{
+	if (!RuntimeConfig::WorldDomainDecomposition() || domains.GetDomainCount() < 2)
 	{
-		if (!(*it)->IsAlive())
+		for (size_t i = 0; i < sheeps.size(); i++)
 		{
-			it = wolves.erase(it);
+			UpdateSheepAt(i, deltaTime);
 		}
-		else
+
+		return;
+	}
+
+	AssignSheepToDomains();
+
+	jobs.ParallelFor(domainWork.size(), 1, [this, deltaTime](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
 		{
-			(*it)->Entity::Update(deltaTime);
-			++it;
+			UpdateDomainSheep(domainWork[i], deltaTime);
 		}
+	});
+
+	RecycleDomainReleases();
+
+	for (size_t i : boundarySheep)
+	{
+		UpdateSheepAt(i, deltaTime);
+	}
+}
+
+// Updates one sheep if it is still alive, tagging its commands with its place in the sheep list.
+void World::UpdateSheepAt(size_t index, float deltaTime)
+{
+	if (sheeps[index]->IsAlive())
+	{
+		GetCommandBuffer().SetIssuer(CommandIssuer(CommandPhase::Sheep, index));
+		sheeps[index]->Entity::Update(deltaTime);
 	}
+}
 
-	std::vector<Vector2> newSheepPositions;
+// Updates the sheep of one domain on the calling thread, deferring their releases and drawing from the domain's own random numbers.
+void World::UpdateDomainSheep(DomainWork& work, float deltaTime)
+{
+	activeDomain = &work;
 
-	// Update sheep
-	for (auto it = sheeps.begin(); it != sheeps.end();)
+	for (size_t i : work.sheep)
 	{
-		if (!(*it)->IsAlive())
+		UpdateSheepAt(i, deltaTime);
+	}
+
+	activeDomain = nullptr;
+}
+
+// Moves the strip edges if the sheep drifted, then hands every sheep to the domain containing it along with its halo, or to the boundary list.
+// Flock members go by the extent of their whole flock so a flock is never split, and a sheep that crossed an edge simply changes owner here.
+void World::AssignSheepToDomains()
+{
+	domains.Rebalance(sheepStore.GetPositionsX(), ValueConfig::World::DomainRebalanceTolerance);
+
+	// Drawn from the shared sequence once per tick, so every domain's numbers follow from the same seed whatever thread runs it.
+	uint64_t tickSeed = (static_cast<uint64_t>(GetRandomValue(0, 32767)) << 15) | static_cast<uint64_t>(GetRandomValue(0, 32767));
+
+	for (size_t d = 0; d < domainWork.size(); d++)
+	{
+		domainWork[d].sheep.clear();
+		domainWork[d].random.Seed((tickSeed << 8) | d);
+	}
+
+	boundarySheep.clear();
+
+	float halo = GetDomainHalo();
+	float entitySize = cellSize;
+
+	for (size_t i = 0; i < sheeps.size(); i++)
+	{
+		if (!sheeps[i]->IsAlive())
 		{
-			it = sheeps.erase(it);
+			continue;
+		}
+
+		float minX = sheeps[i]->GetPosition().x;
+		float maxX = minX + entitySize;
+
+		if (const Flock* flock = sheeps[i]->GetFlock())
+		{
+			minX = std::min(minX, flock->centroid.x - flock->radius);
+			maxX = std::max(maxX, flock->centroid.x + flock->radius + entitySize);
+		}
+
+		int domain = domains.FindDomain(minX - halo, maxX + halo);
+
+		if (domain == DomainDecomposition::Boundary)
+		{
+			boundarySheep.push_back(i);
 		}
 		else
 		{
-			(*it)->SetNewSheepPositions(&newSheepPositions);
-			(*it)->Entity::Update(deltaTime);
-			(*it)->SetNewSheepPositions(nullptr);
+			domainWork[domain].sheep.push_back(i);
+		}
+	}
+}
+
+// Frees the sheep and grass slots and flocks the domains released, in domain order so later reuse does not depend on thread timing.
+void World::RecycleDomainReleases()
+{
+	for (DomainWork& work : domainWork)
+	{
+		for (uint32_t index : work.releasedSheepSlots)
+		{
+			sheepSlots.Recycle(index);
+		}
 
-			++it;
+		for (uint32_t index : work.releasedGrassSlots)
+		{
+			grassSlots.Recycle(index);
 		}
+
+		for (int32_t flockId : work.dissolvedFlocks)
+		{
+			flockRegistry.Recycle(flockId);
+		}
+
+		work.releasedSheepSlots.clear();
+		work.releasedGrassSlots.clear();
+		work.dissolvedFlocks.clear();
 	}
+}
 
-	for (const auto& position : newSheepPositions)
+// Grows the hunger of every sheep sensing this tick, and drains the health of the starving ones, spread over the worker threads.
+// Each sheep only writes its own slot of the sheep store; the ones starved to death die in their own Sense.
+void World::UpdateSheepVitals(float deltaTime)
+{
+	jobs.ParallelFor(sensingSheep.size(), ValueConfig::World::ParallelBatchSize, [this, deltaTime](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			sensingSheep[i]->UpdateVitals(deltaTime);
+		}
+	});
+}
+
+// Rebuilds the threat field from where the wolves ended up.
+void World::RebuildThreatField()
+{
+	threatField.Clear();
+
+	for (const auto& wolf : wolves)
+	{
+		if (wolf->IsAlive())
+		{
+			threatField.AddWolf(wolf->GetPosition());
+		}
+	}
+
+	threatField.Propagate();
+}
+
+// Moves the sheep, applies what entities did to each other, then removes the dead and adds the newborn sheep and grass.
+void World::CommitTick(float deltaTime)
+{
+	IntegrateSheepMovement(deltaTime);
+
+	// Changes entities made to each other land here, before the deaths they cause are processed.
+	ApplyCommands();
+
+	ProcessDeaths();
+	RemoveDeadEntities();
+
+	for (const auto& position : pendingSheepPositions)
 	{
 		CreateSheep(position);
 	}
 
+	pendingSheepPositions.clear();
+
 	// Create new grass from pending positions.
 	for (const auto& positions : pendingGrassPositions)
 	{
@@ -140,63 +345,418 @@ void World::Update(float deltaTime)
 	pendingGrassPositions.clear();
 }
 
-// Renders all grass entities in the world.
-void World::Draw()
+// Lets every wolf and sheep about to sense this tick perceive the world, spreading them over the worker threads.
+// No entity moves, claims or dies until all of them are done, so they only ever read and each writes its own perception.
+void World::PerceiveEntities(float deltaTime)
 {
-	for (const auto& grass : grasses)
+	perceivingEntities.clear();
+	sensingSheep.clear();
+
+	for (const auto& wolf : wolves)
+	{
+		if (wolf->IsAlive() && wolf->IsSenseDue(deltaTime))
+		{
+			perceivingEntities.push_back(wolf.get());
+		}
+	}
+
+	for (const auto& sheep : sheeps)
+	{
+		if (sheep->IsAlive() && sheep->IsSenseDue(deltaTime))
+		{
+			perceivingEntities.push_back(sheep.get());
+			sensingSheep.push_back(sheep.get());
+		}
+	}
+
+	auto perceive = [this](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			perceivingEntities[i]->Perceive();
+		}
+	};
+
+	if (RuntimeConfig::WorldParallelSense())
+	{
+		jobs.ParallelFor(perceivingEntities.size(), ValueConfig::World::ParallelBatchSize, perceive);
+	}
+	else
+	{
+		perceive(0, perceivingEntities.size());
+	}
+}
+
+// Applies the velocity every wolf state asked for this tick. There are only a handful of wolves, so they move one by one through SetPosition.
+void World::IntegrateWolfMovement(float deltaTime)
+{
+	for (const auto& wolf : wolves)
+	{
+		Vector2 velocity = wolf->GetDesiredVelocity();
+
+		if (velocity.x == 0.0f && velocity.y == 0.0f)
+		{
+			continue;
+		}
+
+		Vector2 position = wolf->GetPosition();
+
+		wolf->SetPosition({ position.x + velocity.x * deltaTime, position.y + velocity.y * deltaTime });
+		wolf->SetDesiredVelocity({ 0.0f, 0.0f });
+	}
+}
+
+// Moves every sheep in one pass over the store, then carries the sheep that actually moved over to their new grid buckets.
+void World::IntegrateSheepMovement(float deltaTime)
+{
+	sheepStore.Integrate(deltaTime, movementBounds);
+
+	const auto& owners = sheepStore.GetOwners();
+
+	for (size_t slot = 0; slot < owners.size(); slot++)
+	{
+		Vector2 oldPosition = sheepStore.GetPreviousPosition(slot);
+		Vector2 newPosition = sheepStore.GetPosition(slot);
+
+		if (oldPosition.x != newPosition.x || oldPosition.y != newPosition.y)
+		{
+			sheepGrid.Move(owners[slot], oldPosition, newPosition);
+		}
+	}
+}
+
+// Merges the command buffers of every thread into the order the entities that issued them update in, then applies them one by one.
+// Each issuer only ever records into one buffer per tick, so sorting on issuer and sequence alone gives the same order however the work was split.
+void World::ApplyCommands()
+{
+	mergedCommands.clear();
+
+	for (CommandBuffer& buffer : commandBuffers)
+	{
+		mergedCommands.insert(mergedCommands.end(), buffer.GetCommands().begin(), buffer.GetCommands().end());
+		buffer.Clear();
+	}
+
+	std::sort(mergedCommands.begin(), mergedCommands.end(), [](const WorldCommand& a, const WorldCommand& b)
+	{
+		return a.issuer != b.issuer ? a.issuer < b.issuer : a.sequence < b.sequence;
+	});
+
+	for (const WorldCommand& command : mergedCommands)
+	{
+		std::visit([this](const auto& action) { ApplyCommand(action); }, command.action);
+	}
+}
+
+// Takes the damage off the sheep if it is still alive, killing it when its health runs out.
+void World::ApplyCommand(const DamageSheepCommand& command)
+{
+	SheepStateMachine* sheep = GetSheep(command.sheep);
+
+	if (sheep && sheep->IsAlive())
+	{
+		sheep->SetHealth(std::max(0.0f, sheep->GetHealth() - command.amount));
+	}
+}
+
+// Groups the sheep with the other one, unless a command applied before this one already put it in a group or it stopped wandering alone.
+void World::ApplyCommand(const JoinGroupCommand& command)
+{
+	SheepStateMachine* sheep = GetSheep(command.sheep);
+	SheepStateMachine* other = GetSheep(command.other);
+
+	if (!sheep || !other || !sheep->IsAlive() || !other->IsAlive() || sheep->IsInGroup() || sheep->GetCurrentState() != SheepStateMachine::SheepState::WanderingAlone)
+	{
+		return;
+	}
+
+	if (other->IsInGroup())
+	{
+		if (flockRegistry.Join(other->GetGroupId(), sheep))
+		{
+			sheep->SwitchState<WanderingInGroupState>(sheep);
+		}
+	}
+	else
 	{
-		grass->Draw();
+		flockRegistry.Create(sheep, other);
+
+		other->SwitchState<WanderingInGroupState>(other);
+
+		sheep->SwitchState<WanderingInGroupState>(sheep);
 	}
+}
+
+// Queues the newborn so it is created after the dead of this tick are removed.
+void World::ApplyCommand(const SpawnSheepCommand& command)
+{
+	pendingSheepPositions.push_back(command.position);
+}
 
-	for (const auto& poop : sheepPoopInstances)
+// Spawns the particles of the given kind.
+void World::ApplyCommand(const SpawnParticleCommand& command)
+{
+	if (command.kind == ParticleKind::Poop)
+	{
+		AddSheepPoop(command.position);
+	}
+	else
 	{
-		float alpha = 1.0f - (poop.lifetime / SheepPoopInstance::maxLifetime);
-		Color poopColor = { 139, 69, 19, static_cast<unsigned char>(255 * alpha) };
+		AddBloodSplatter(command.position);
+	}
+}
 
-		DrawCircle(static_cast<int>(poop.position.x + ValueConfig::World::CellSize * scaleFactor / 2), static_cast<int>(poop.position.y + ValueConfig::World::CellSize * scaleFactor / 2), 5.0f * scaleFactor, poopColor);
+// Flags the sheep as reproducing and shows it as such, or clears the flag and returns it to its group once reproduction is over.
+void World::ApplyCommand(const SetReproducingCommand& command)
+{
+	SheepStateMachine* sheep = GetSheep(command.sheep);
+
+	if (!sheep || !sheep->IsAlive())
+	{
+		return;
 	}
 
-	for (const auto& splatter : bloodSplatters)
+	sheep->SetIsReproducing(command.reproducing);
+
+	if (command.reproducing)
+	{
+		sheep->SetCurrentState(SheepStateMachine::SheepState::Reproducing);
+	}
+	else if (sheep->GetCurrentState() == SheepStateMachine::SheepState::Reproducing)
 	{
-		float alpha = 1.0f - (splatter.lifetime / BloodSplatterInstance::maxLifetime);
+		sheep->SetCurrentState(SheepStateMachine::SheepState::WanderingInGroup);
+	}
+}
+
+// Detaches every entity that died this tick from the rest of the world before any of them is destroyed.
+void World::ProcessDeaths()
+{
+	for (const auto& sheep : sheeps)
+	{
+		if (!sheep->IsAlive())
+		{
+			sheep->LeaveGroup();
+
+			// The hunting wolf notices through its stale handle, only the reservation itself has to go.
+			huntReservations.erase(sheep.get());
+
+			sheepGrid.Remove(sheep.get(), sheep->GetPosition());
+		}
+	}
+
+	for (const auto& wolf : wolves)
+	{
+		if (!wolf->IsAlive())
+		{
+			wolf->SetTargetSheep(nullptr);
+
+			wolfGrid.Remove(wolf.get(), wolf->GetPosition());
+		}
+	}
+
+	for (const auto& grass : grasses)
+	{
+		if (!grass->IsAlive())
+		{
+			int cellIndex = GetCellIndex(grass->GetPosition());
+
+			if (cellIndex >= 0 && grassCells[cellIndex] == grass.get())
+			{
+				grassCells[cellIndex] = nullptr;
+			}
+		}
+	}
+}
+
+// Removes all dead entities in a single sweep per container, filling each gap with the last element.
+void World::RemoveDeadEntities()
+{
+	SwapAndPopIf(grasses, [](const GrassStateMachine& grass) { return !grass.IsAlive(); });
+	SwapAndPopIf(wolves, [](const WolfStateMachine& wolf) { return !wolf.IsAlive(); });
+	SwapAndPopIf(sheeps, [](const SheepStateMachine& sheep) { return !sheep.IsAlive(); });
+}
 
-		Color bloodColor;
+// Erases every entity matching the predicate without preserving order, so each removal costs a single move.
+template<typename T, typename Predicate>
+void World::SwapAndPopIf(std::vector<std::unique_ptr<T>>& entities, Predicate&& predicate)
+{
+	size_t count = entities.size();
 
-		if (splatter.size > 6.0f)
+	for (size_t i = 0; i < count;)
+	{
+		if (predicate(*entities[i]))
 		{
-			bloodColor = { 139, 0, 0, static_cast<unsigned char>(255 * alpha) };
+			entities[i] = std::move(entities[count - 1]);
+			count--;
 		}
 		else
 		{
-			bloodColor = { 220, 20, 20, static_cast<unsigned char>(255 * alpha) };
+			i++;
 		}
+	}
+
+	entities.erase(entities.begin() + static_cast<std::ptrdiff_t>(count), entities.end());
+}
 
-		DrawCircle(static_cast<int>(splatter.position.x), static_cast<int>(splatter.position.y), splatter.size * scaleFactor, bloodColor);
+// Copies what the window needs to draw and list the entities into the snapshot, reusing its vectors' storage.
+// Sheep are written in sheep store order, so a group leader is referred to by its store slot.
+void World::WriteSnapshot(RenderSnapshot& snapshot) const
+{
+	snapshot.grass.clear();
+	snapshot.sheep.clear();
+	snapshot.wolves.clear();
+	snapshot.particles.clear();
+
+	for (const auto& grass : grasses)
+	{
+		snapshot.grass.push_back({ grass->GetPosition(), grass->GetCurrentState(), static_cast<uint8_t>(grass->GetGrowthStage()), grass->IsBeingEaten() });
+	}
+
+	const std::vector<SheepStateMachine*>& owners = sheepStore.GetOwners();
+
+	for (size_t slot = 0; slot < owners.size(); slot++)
+	{
+		const SheepStateMachine* sheep = owners[slot];
+		const SheepStateMachine* leader = sheep->GetGroupLeader();
+
+		int32_t leaderSlot = leader ? static_cast<int32_t>(leader->GetStoreSlot()) : -1;
+
+		snapshot.sheep.push_back({ sheepStore.GetPosition(slot), sheepStore.GetHealth(slot), sheepStore.GetHunger(slot), leaderSlot, sheepStore.GetActivity(slot), sheep->IsInGroup(), sheep->IsGroupLeader(), sheep->IsReproducing() });
 	}
 
 	for (const auto& wolf : wolves)
 	{
-		wolf->Draw();
+		const SheepStateMachine* target = wolf->GetTargetSheep();
+
+		Vector2 targetPosition = target ? target->GetPosition() : wolf->GetPosition();
+
+		snapshot.wolves.push_back({ wolf->GetPosition(), targetPosition, wolf->GetHunger(), wolf->GetStamina(), wolf->GetCurrentState(), target != nullptr, wolf->IsTired() });
 	}
 
-	for (const auto& sheep : sheeps)
+	poopParticles.WriteSnapshot(snapshot.particles);
+	bloodParticles.WriteSnapshot(snapshot.particles);
+
+	snapshot.worldSize = { GetMaxX(), GetMaxY() };
+	snapshot.cellSize = cellSize;
+}
+
+// Returns how far around a sheep the domain it is updated in must reach, covering the sheep and grass it can see and how far it can move in a tick.
+// Wolves are left out, since they do not move while the sheep update and so are only ever read.
+float World::GetDomainHalo() const
+{
+	return std::max(RuntimeConfig::SheepGroupRadius(), RuntimeConfig::SheepGrassDetectionRadius()) + cellSize;
+}
+
+// Converts a grid position to an index into the cell table, or -1 if it lies outside the world.
+int World::GetCellIndex(Vector2 position) const
+{
+	if (position.x < 0.0f || position.y < 0.0f)
 	{
-		sheep->Draw();
+		return -1;
 	}
+
+	int cellX = static_cast<int>(position.x);
+	int cellY = static_cast<int>(position.y);
+
+	if (cellX >= width || cellY >= height)
+	{
+		return -1;
+	}
+
+	return cellY * width + cellX;
+}
+
+// Returns the grass occupying a grid cell, or null if the cell is empty or outside the world.
+GrassStateMachine* World::GetGrassAt(Vector2 position) const
+{
+	int cellIndex = GetCellIndex(position);
+
+	return cellIndex >= 0 ? grassCells[cellIndex] : nullptr;
 }
 
 // Checks if a cell is occupied by grass.
 bool World::IsCellOccupied(Vector2 position) const
 {
-	for (const auto& grass : grasses)
+	return GetGrassAt(position) != nullptr;
+}
+
+// Adds or removes grass from the index of fully grown grass that no sheep is eating yet.
+void World::SetGrassEdible(GrassStateMachine* grass, bool edible)
+{
+	Vector2 grassPosition = CoordinateUtils::GridToWorldPosition(grass->GetPosition(), cellSize);
+
+	if (edible)
 	{
-		if (grass->GetPosition().x == position.x && grass->GetPosition().y == position.y)
-		{
-			return true;
-		}
+		edibleGrassGrid.Insert(grass, grassPosition);
 	}
+	else
+	{
+		edibleGrassGrid.Remove(grass, grassPosition);
+	}
+}
 
-	return false;
+// Invalidates a grass handle, holding its slot back until the domains are done when called from one of them.
+void World::ReleaseGrassHandle(GrassHandle handle)
+{
+	if (!activeDomain)
+	{
+		grassSlots.Remove(handle);
+	}
+	else if (grassSlots.Retire(handle))
+	{
+		activeDomain->releasedGrassSlots.push_back(handle.index);
+	}
+}
+
+// Invalidates a sheep handle, holding its slot back until the domains are done when called from one of them.
+void World::ReleaseSheepHandle(SheepHandle handle)
+{
+	if (!activeDomain)
+	{
+		sheepSlots.Remove(handle);
+	}
+	else if (sheepSlots.Retire(handle))
+	{
+		activeDomain->releasedSheepSlots.push_back(handle.index);
+	}
+}
+
+// Frees a dissolved flock for reuse, holding it back until the domains are done when called from one of them.
+void World::ReleaseFlock(int32_t flockId)
+{
+	if (activeDomain)
+	{
+		activeDomain->dissolvedFlocks.push_back(flockId);
+	}
+	else
+	{
+		flockRegistry.Recycle(flockId);
+	}
+}
+
+// Returns a random value between min and max, both included, from the active domain's numbers when called from one and the shared sequence otherwise.
+int World::RandomValue(int min, int max)
+{
+	return activeDomain ? activeDomain->random.GetValue(min, max) : GetRandomValue(min, max);
+}
+
+// Releases a wolf's claim on a sheep, leaving claims made by other wolves untouched.
+void World::ReleaseHuntReservation(const SheepStateMachine* sheep, const WolfStateMachine* wolf)
+{
+	auto reservation = huntReservations.find(sheep);
+
+	if (reservation != huntReservations.end() && reservation->second == wolf)
+	{
+		huntReservations.erase(reservation);
+	}
+}
+
+// Checks if a sheep is already claimed as prey by a wolf other than the one asking.
+bool World::IsSheepHuntedByOther(const SheepStateMachine* sheep, const WolfStateMachine* wolf) const
+{
+	auto reservation = huntReservations.find(sheep);
+
+	return reservation != huntReservations.end() && reservation->second != wolf;
 }
 
 // Adds spacing check and reduce spread chance.
@@ -227,9 +787,9 @@ bool World::IsAdjacentToGrass(Vector2 position) const
 }
 
 // Retrieves a list of valid neighboring cell positions.
-std::vector<Vector2> World::GetNeighboringCells(Vector2 position) const
+CellNeighbors World::GetNeighboringCells(Vector2 position) const
 {
-	std::vector<Vector2> neighbors;
+	CellNeighbors neighbors;
 
 	for (int dx = -1; dx <= 1; dx++)
 	{
@@ -247,7 +807,7 @@ std::vector<Vector2> World::GetNeighboringCells(Vector2 position) const
 
 			if (newPosition.x >= 0 && newPosition.x < width && newPosition.y >= 0 && newPosition.y < height)
 			{
-				neighbors.push_back(newPosition);
+				neighbors.cells[neighbors.count++] = newPosition;
 			}
 		}
 	}
@@ -272,26 +832,32 @@ void World::SpreadSeeds(const Vector2& position)
 // Creates and initializes a new grass entity at the specified position.
 void World::CreateGrass(Vector2 position)
 {
-	if (scaleFactor <= 0.5f) 
-	{
-		float minGridY = minY / (cellSize * scaleFactor);
+	int cellIndex = GetCellIndex(position);
 
-		if (position.y < minGridY)
-		{
-			position.y = minGridY;
-		}
+	if (cellIndex >= 0 && grassCells[cellIndex])
+	{
+		return;
 	}
 
-	auto grass = std::make_unique<GrassStateMachine>(this, position, scaleFactor);
+	auto grass = std::make_unique<GrassStateMachine>(this, position);
+	grass->SetHandle(grassSlots.Insert(grass.get()));
 	grass->Initialize();
 
+	if (cellIndex >= 0)
+	{
+		grassCells[cellIndex] = grass.get();
+	}
+
 	grasses.push_back(std::move(grass));
 }
 
 // Creates and initializes a new wolf entity at the specified position.
 void World::CreateWolf(Vector2 position)
 {
-	auto wolf = std::make_unique<WolfStateMachine>(this, position, scaleFactor);
+	auto wolf = std::make_unique<WolfStateMachine>(this, position);
+	wolf->SetHandle(wolfSlots.Insert(wolf.get()));
+	wolf->SetDenIndex(dens.FindNearest(wolf->GetPosition()));
+	wolfGrid.Insert(wolf.get(), wolf->GetPosition());
 	wolf->Initialize();
 
 	wolves.push_back(std::move(wolf));
@@ -300,162 +866,111 @@ void World::CreateWolf(Vector2 position)
 // Creates and initializes a new sheep entity at the specified position.
 void World::CreateSheep(Vector2 position)
 {
-	float sheepSize = ValueConfig::World::CellSize * scaleFactor;
-	float minimumY = GetMinY();
-	float rightMargin = 4.0f * scaleFactor;
-	float bottomMargin = 4.0f * scaleFactor;
+	position = movementBounds.Clamp(position);
 
-	float maxX = static_cast<float>(GetScreenWidth() * 3.0f / 4.0f - sheepSize - rightMargin);
-	float maxY = static_cast<float>(GetScreenHeight() * 2.0f / 3.0f - sheepSize - bottomMargin);
-
-	if (scaleFactor <= 0.5f && position.y < minimumY) 
-	{
-		position.y = minimumY;
-	}
-
-	position.x = std::max(0.0f, std::min(position.x, maxX));
-	position.y = std::max(minimumY, std::min(position.y, maxY));
-
-	auto sheep = std::make_unique<SheepStateMachine>(this, position, scaleFactor);
+	auto sheep = std::make_unique<SheepStateMachine>(this, position);
+	sheep->SetHandle(sheepSlots.Insert(sheep.get()));
 	sheep->Initialize();
 
 	if (sheeps.size() > 0)
 	{
-		float closestDistance = RuntimeConfig::SheepGroupRadius() * scaleFactor;
-		SheepStateMachine* closestSheep = nullptr;
+		float groupRadius = RuntimeConfig::SheepGroupRadius();
 
-		for (const auto& otherSheep : sheeps)
-		{
-			if (!otherSheep->IsAlive())
-			{
-				continue;
-			}
-
-			float dx = position.x - otherSheep->GetPosition().x;
-			float dy = position.y - otherSheep->GetPosition().y;
-			float distance = static_cast<float>(sqrt(dx * dx + dy * dy));
-
-			if (distance < closestDistance)
-			{
-				closestDistance = distance;
-				closestSheep = otherSheep.get();
-			}
-		}
+		SheepStateMachine* closestSheep = sheepGrid.FindNearest(position, groupRadius, [](const SheepStateMachine* otherSheep) { return otherSheep->IsAlive(); });
 
 		if (closestSheep)
 		{
 			if (closestSheep->IsInGroup())
 			{
-				SheepStateMachine* leader = closestSheep->GetGroupLeader() ? closestSheep->GetGroupLeader() : closestSheep;
-
-				if (leader->GetGroupSize() < RuntimeConfig::SheepMaxGroupSize())
+				if (flockRegistry.Join(closestSheep->GetGroupId(), sheep.get()))
 				{
-					leader->AddToGroup(sheep.get());
-					sheep->SetGroupLeader(leader);
 					sheep->SetCurrentState(SheepStateMachine::SheepState::WanderingInGroup);
-					sheep->SwitchState(std::make_unique<WanderingInGroupState>(sheep.get()));
+					sheep->SwitchState<WanderingInGroupState>(sheep.get());
 				}
 			}
 			else
 			{
-				sheep->AddToGroup(closestSheep);
-				closestSheep->SetGroupLeader(sheep.get());
+				flockRegistry.Create(sheep.get(), closestSheep);
 				closestSheep->SetCurrentState(SheepStateMachine::SheepState::WanderingInGroup);
-				closestSheep->SwitchState(std::make_unique<WanderingInGroupState>(closestSheep));
+				closestSheep->SwitchState<WanderingInGroupState>(closestSheep);
 
 				sheep->SetCurrentState(SheepStateMachine::SheepState::WanderingInGroup);
-				sheep->SwitchState(std::make_unique<WanderingInGroupState>(sheep.get()));
+				sheep->SwitchState<WanderingInGroupState>(sheep.get());
 			}
 		}
 	}
 
+	sheepGrid.Insert(sheep.get(), sheep->GetPosition());
 	sheeps.push_back(std::move(sheep));
 }
 
-// Adds a new sheep poop instance at the specified position.
+// Spawns a sheep poop particle and stamps its contamination footprint onto the cells around it.
 void World::AddSheepPoop(Vector2 position)
 {
-	sheepPoopInstances.push_back({ position, 0.0f });
-}
+	Vector2 particlePosition = { position.x + cellSize / 2, position.y + cellSize / 2 };
 
-// Updates and removes sheep poop.
-void World::UpdateSheepPoop(float deltaTime)
-{
-	for (auto it = sheepPoopInstances.begin(); it != sheepPoopInstances.end();)
-	{
-		it->lifetime += deltaTime;
+	poopParticles.Spawn(particlePosition, 5.0f, { 139, 69, 19, 255 });
 
-		if (it->lifetime >= SheepPoopInstance::maxLifetime)
-		{
-			it = sheepPoopInstances.erase(it);
-		}
-		else
+	float radius = ValueConfig::Sheep::PoopContaminationRadius;
+	float radiusSquared = radius * radius;
+	float expiry = simulationTime + ValueConfig::World::PoopLifetime;
+
+	int minCellX = std::max(0, static_cast<int>(floorf((position.x - radius) / cellSize)));
+	int maxCellX = std::min(width - 1, static_cast<int>(ceilf((position.x + radius) / cellSize)));
+	int minCellY = std::max(0, static_cast<int>(floorf((position.y - radius) / cellSize)));
+	int maxCellY = std::min(height - 1, static_cast<int>(ceilf((position.y + radius) / cellSize)));
+
+	for (int cellY = minCellY; cellY <= maxCellY; cellY++)
+	{
+		for (int cellX = minCellX; cellX <= maxCellX; cellX++)
 		{
-			++it;
+			float dx = cellX * cellSize - position.x;
+			float dy = cellY * cellSize - position.y;
+
+			if (dx * dx + dy * dy < radiusSquared)
+			{
+				float& cellExpiry = poopContaminationExpiry[cellY * width + cellX];
+				cellExpiry = std::max(cellExpiry, expiry);
+			}
 		}
 	}
 }
 
-// Checks if sheep poop is nearby within a specified radius.
-bool World::IsSheepPoopNearby(Vector2 position, float radius) const
+// Checks if the cell at a world position is still inside the footprint of recent sheep poop.
+bool World::IsSheepPoopNearby(Vector2 position) const
 {
-	float scaledRadius = radius * scaleFactor;
-	float _minY = GetMinY();
-
-	for (const auto& sheepPoop : sheepPoopInstances)
+	if (position.x < 0.0f || position.y < 0.0f)
 	{
-		Vector2 poopPosition = sheepPoop.position;
-
-		if (scaleFactor <= 0.5f && poopPosition.y < _minY) 
-		{
-			poopPosition.y = _minY;
-		}
+		return false;
+	}
 
-		float dx = position.x - poopPosition.x;
-		float dy = position.y - poopPosition.y;
-		float distanceSquared = dx * dx + dy * dy;
+	int cellX = static_cast<int>(position.x / cellSize);
+	int cellY = static_cast<int>(position.y / cellSize);
 
-		if (distanceSquared < scaledRadius * scaledRadius)
-		{
-			return true;
-		}
+	if (cellX >= width || cellY >= height)
+	{
+		return false;
 	}
 
-	return false;
+	return poopContaminationExpiry[cellY * width + cellX] > simulationTime;
 }
 
-// Adds a new blood splatter instance at the specified position.
+// Spawns a burst of blood splatter particles around the specified position.
 void World::AddBloodSplatter(Vector2 position)
 {
 	int numberOfSplatters = GetRandomValue(8, 15);
 
 	for (int i = 0; i < numberOfSplatters; i++)
 	{
-		float offsetX = static_cast<float>(GetRandomValue(-60, 60)) * scaleFactor;
-		float offsetY = static_cast<float>(GetRandomValue(-60, 60)) * scaleFactor;
+		float offsetX = static_cast<float>(GetRandomValue(-60, 60));
+		float offsetY = static_cast<float>(GetRandomValue(-60, 60));
 
-		float size = static_cast<float>(GetRandomValue(2, 6)) * scaleFactor;
+		float size = static_cast<float>(GetRandomValue(2, 6));
 
 		Vector2 splatterPosition = { position.x + offsetX, position.y + offsetY };
 
-		bloodSplatters.push_back({ splatterPosition, 0.0f, size });
-	}
-}
-
-// Updates and removes blood splatters.
-void World::UpdateBloodSplatters(float deltaTime)
-{
-	for (auto it = bloodSplatters.begin(); it != bloodSplatters.end();)
-	{
-		it->lifetime += deltaTime;
+		Color bloodColor = size > 6.0f ? Color{ 139, 0, 0, 255 } : Color{ 220, 20, 20, 255 };
 
-		if (it->lifetime >= BloodSplatterInstance::maxLifetime)
-		{
-			it = bloodSplatters.erase(it);
-		}
-		else
-		{
-			++it;
-		}
+		bloodParticles.Spawn(splatterPosition, size, bloodColor);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,396 @@
+#include <Utility/SimulationConfig.h>
+#include <World/WorldRenderer.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+	// Returns whether a sheep in this activity shows the line to the rest of its group.
+	bool ShowsGroupLine(const SheepSnapshot& sheep)
+	{
+		return sheep.activity == SheepActivity::WanderingInGroup || sheep.activity == SheepActivity::Reproducing || (sheep.inGroup && (sheep.activity == SheepActivity::Eating || sheep.activity == SheepActivity::Defecating));
+	}
+}
+
+
+// Loads every texture the world is drawn with, which has to happen on the thread that owns the window.
+WorldRenderer::WorldRenderer()
+{
+	seedsPlantedTextures[0] = textureCache.Acquire("Assets/Grass/Growing/TestGrass1.png");
+	seedsPlantedTextures[1] = textureCache.Acquire("Assets/Grass/Growing/TestGrass2.png");
+	seedsPlantedTextures[2] = textureCache.Acquire("Assets/Grass/Growing/TestGrass3.png");
+	seedsPlantedTextures[3] = textureCache.Acquire("Assets/Grass/Growing/TestGrass4.png");
+	seedsPlantedTextures[4] = textureCache.Acquire("Assets/Grass/Growing/TestGrass5.png");
+	seedsPlantedTextures[5] = textureCache.Acquire("Assets/Grass/Growing/TestGrass6.png");
+
+	fullyGrownTexture = textureCache.Acquire("Assets/Grass/FullyGrown/TestGrass7.png");
+
+	wiltingTexture = textureCache.Acquire("Assets/Grass/Wilting/TestGrass8.png");
+
+	sheepTexture = textureCache.Acquire("Assets/Sheep/TestSheep.png");
+	wolfTexture = textureCache.Acquire("Assets/Wolf/TestWolf.png");
+}
+
+// Renders only what lies in or near the visible area, leaving out the small overlays when the view is zoomed too far out to read them.
+void WorldRenderer::Draw(const RenderSnapshot& snapshot, Rectangle visibleArea, float zoom, bool showDetectionRadii)
+{
+	cellSize = snapshot.cellSize;
+
+	bool drawDetail = zoom >= ValueConfig::Camera::DetailZoomThreshold;
+
+	float margin = ValueConfig::World::CullMargin;
+
+	Rectangle area = { visibleArea.x - margin, visibleArea.y - margin, visibleArea.width + margin * 2, visibleArea.height + margin * 2 };
+
+	for (const GrassSnapshot& grass : snapshot.grass)
+	{
+		if (CheckCollisionPointRec({ grass.cell.x * cellSize, grass.cell.y * cellSize }, area))
+		{
+			DrawGrass(grass);
+		}
+	}
+
+	for (const ParticleSnapshot& particle : snapshot.particles)
+	{
+		if (CheckCollisionCircleRec(particle.position, particle.radius, area))
+		{
+			DrawCircleV(particle.position, particle.radius, particle.color);
+		}
+	}
+
+	for (const WolfSnapshot& wolf : snapshot.wolves)
+	{
+		if (CheckCollisionPointRec(wolf.position, area))
+		{
+			DrawWolf(wolf, showDetectionRadii, drawDetail);
+		}
+	}
+
+	for (const SheepSnapshot& sheep : snapshot.sheep)
+	{
+		if (CheckCollisionPointRec(sheep.position, area))
+		{
+			DrawSheep(sheep, showDetectionRadii);
+		}
+	}
+
+	if (drawDetail)
+	{
+		DrawGroupLines(snapshot, area);
+		DrawSheepStatusBars(snapshot, area);
+	}
+}
+
+// Renders the grass with the texture of its growth stage and a square colored by its current state.
+void WorldRenderer::DrawGrass(const GrassSnapshot& grass) const
+{
+	Color stateColor;
+	Texture2D textureToUse = {};
+
+	switch (grass.state)
+	{
+	case GrassStateMachine::GrassState::SeedsPlanted:
+		stateColor = { 0, 255, 102, 255 };
+		textureToUse = seedsPlantedTextures[std::min<int>(grass.growthStage, 5)].Get();
+		break;
+
+	case GrassStateMachine::GrassState::FullyGrown:
+		stateColor = { 0, 100, 0, 255 };
+		textureToUse = fullyGrownTexture.Get();
+		break;
+
+	case GrassStateMachine::GrassState::Wilting:
+		stateColor = BROWN;
+		textureToUse = wiltingTexture.Get();
+		break;
+
+	default:
+		stateColor = WHITE;
+		textureToUse = seedsPlantedTextures[0].Get();
+		break;
+	}
+
+	float drawX = grass.cell.x * cellSize;
+	float drawY = grass.cell.y * cellSize;
+
+	if (textureToUse.id != 0)
+	{
+		Rectangle sourceRec = { 0.0f, 0.0f, static_cast<float>(textureToUse.width), static_cast<float>(textureToUse.height) };
+		Rectangle destRec = { drawX, drawY, cellSize, cellSize };
+		Vector2 origin = { 0.0f, 0.0f };
+
+		DrawTexturePro(textureToUse, sourceRec, destRec, origin, 0.0f, WHITE);
+	}
+
+	float squareOffset = 5.0f;
+	float squareScale = 0.5f;
+	float squareSize = cellSize / 2 * squareScale;
+
+	Vector2 center = { drawX + cellSize / 2, drawY + cellSize / 2 };
+	Vector2 squarePosition = { center.x - squareSize / 2, drawY + cellSize + squareOffset };
+
+	DrawRectangle(static_cast<int>(squarePosition.x), static_cast<int>(squarePosition.y), static_cast<int>(squareSize), static_cast<int>(squareSize), stateColor);
+}
+
+// Renders the sheep with a triangle colored by its current state, and its detection ranges when they are shown.
+void WorldRenderer::DrawSheep(const SheepSnapshot& sheep, bool showDetectionRadii) const
+{
+	Vector2 position = sheep.position;
+
+	if (showDetectionRadii)
+	{
+		Vector2 centerForOutline = { position.x + cellSize / 2, position.y + cellSize / 2 };
+
+		Color skyBlueOutlineColor = { 102, 191, 255, 50 };
+		Color magentaOutlineColor = { 255, 0, 255, 30 };
+		Color redOutlineColor = { 230, 41, 55, 30 };
+
+		DrawCircleLines(static_cast<int>(centerForOutline.x), static_cast<int>(centerForOutline.y), RuntimeConfig::SheepWolfDetectionRadius(), skyBlueOutlineColor);
+		DrawCircleLines(static_cast<int>(centerForOutline.x), static_cast<int>(centerForOutline.y), RuntimeConfig::SheepGrassDetectionRadius(), magentaOutlineColor);
+		DrawCircleLines(static_cast<int>(centerForOutline.x), static_cast<int>(centerForOutline.y), RuntimeConfig::SheepGroupRadius(), redOutlineColor);
+	}
+
+	float halfSize = cellSize / 2;
+
+	Vector2 center = { position.x + halfSize, position.y + halfSize };
+
+	const Texture2D& texture = sheepTexture.Get();
+
+	Rectangle sourceRec = { 0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height) };
+	Rectangle destRec = { position.x, position.y, cellSize, cellSize };
+	Vector2 origin = { 0.0f, 0.0f };
+
+	DrawTexturePro(texture, sourceRec, destRec, origin, 0.0f, WHITE);
+
+	float triangleOffset = 5.0f;
+	float triangleScale = 0.3f;
+	float smallHalfSize = halfSize * triangleScale;
+
+	Vector2 triangleCenter = { center.x, position.y + cellSize + triangleOffset };
+
+	Vector2 point1 = { triangleCenter.x + smallHalfSize, triangleCenter.y };
+	Vector2 point2 = { triangleCenter.x - smallHalfSize, triangleCenter.y - smallHalfSize };
+	Vector2 point3 = { triangleCenter.x - smallHalfSize, triangleCenter.y + smallHalfSize };
+
+	Color sheepColor;
+
+	if (sheep.activity == SheepActivity::WanderingInGroup)
+	{
+		sheepColor = { 25, 25, 153, 255 };
+	}
+	else if (sheep.activity == SheepActivity::RunningAway)
+	{
+		sheepColor = { 255, 0, 51, 255 };
+	}
+	else if (sheep.activity == SheepActivity::Defecating)
+	{
+		sheepColor = { 255, 128, 0, 255 };
+	}
+	else if (sheep.activity == SheepActivity::Eating)
+	{
+		sheepColor = { 102, 51, 153, 255 };
+	}
+	else if (sheep.activity == SheepActivity::Reproducing && sheep.reproducing)
+	{
+		sheepColor = PINK;
+	}
+	else
+	{
+		sheepColor = { 135, 206, 250, 255 };
+	}
+
+	DrawTriangle(point1, point2, point3, sheepColor);
+}
+
+// Renders the wolf with a circle colored by its current state, plus its stamina bar and hunting line when details are shown.
+void WorldRenderer::DrawWolf(const WolfSnapshot& wolf, bool showDetectionRadii, bool drawDetail) const
+{
+	Color wolfColor;
+
+	Color tiredColor = { 160, 160, 160, 255 };
+
+	Vector2 drawPosition = wolf.position;
+
+	if (showDetectionRadii)
+	{
+		Vector2 centerForOutline = { drawPosition.x + cellSize / 2, drawPosition.y + cellSize / 2 };
+		Color outlineColor = { 0, 0, 0, 20 };
+
+		DrawCircleLines(static_cast<int>(centerForOutline.x), static_cast<int>(centerForOutline.y), RuntimeConfig::WolfSheepDetectionRadius(), outlineColor);
+	}
+
+	Vector2 center = { drawPosition.x + cellSize / 2, drawPosition.y + cellSize / 2 };
+
+	const Texture2D& texture = wolfTexture.Get();
+
+	Rectangle sourceRec = { 0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height) };
+	Rectangle destRec = { drawPosition.x, drawPosition.y, cellSize, cellSize };
+	Vector2 origin = { 0.0f, 0.0f };
+
+	DrawTexturePro(texture, sourceRec, destRec, origin, 0.0f, WHITE);
+
+	switch (wolf.state)
+	{
+	case WolfStateMachine::WolfState::Sleeping:
+		wolfColor = BLACK;
+		break;
+	case WolfStateMachine::WolfState::Roaming:
+		wolfColor = { 255, 255, 0, 255 };
+		break;
+	case WolfStateMachine::WolfState::Hunting:
+		wolfColor = wolf.tired ? tiredColor : Color{ 128, 0, 0, 255 };
+		break;
+	case WolfStateMachine::WolfState::Eating:
+		wolfColor = { 4, 102, 100, 255 };
+		break;
+	case WolfStateMachine::WolfState::ReturnToDen:
+		wolfColor = { 128, 191, 51, 255 };
+		break;
+	default:
+		wolfColor = { 128, 128, 128, 255 };
+		break;
+	}
+
+	float circleOffset = 5.0f;
+	float circleScale = 0.3f;
+	float smallRadius = cellSize / 2 * circleScale;
+
+	Vector2 circleCenter = { center.x, drawPosition.y + cellSize + circleOffset };
+
+	DrawCircle(static_cast<int>(circleCenter.x), static_cast<int>(circleCenter.y), smallRadius, wolfColor);
+
+	if (!drawDetail)
+	{
+		return;
+	}
+
+	DrawWolfStatusBars(center, wolf.stamina);
+
+	DrawHuntingLine(wolf);
+}
+
+// Draws the wolf's stamina bar above it.
+void WorldRenderer::DrawWolfStatusBars(Vector2 barPosition, float staminaValue) const
+{
+	const float barWidth = 30.0f;
+	const float barHeight = 4.0f;
+	const float barY = barPosition.y - cellSize / 2 - 10.0f;
+
+	DrawRectangle(static_cast<int>(barPosition.x - barWidth / 2), static_cast<int>(barY), static_cast<int>(barWidth), static_cast<int>(barHeight), GRAY);
+
+	float staminaPercentage = staminaValue / RuntimeConfig::WolfStaminaMax();
+
+	DrawRectangle(static_cast<int>(barPosition.x - barWidth / 2), static_cast<int>(barY), static_cast<int>(barWidth * staminaPercentage), static_cast<int>(barHeight), { 128, 0, 32, 255 });
+}
+
+// Draws a dashed line from a hunting wolf to the sheep it is after.
+void WorldRenderer::DrawHuntingLine(const WolfSnapshot& wolf) const
+{
+	if (wolf.state != WolfStateMachine::WolfState::Hunting || !wolf.hasTarget)
+	{
+		return;
+	}
+
+	Vector2 wolfCenter = { wolf.position.x + cellSize / 2, wolf.position.y + cellSize / 2 };
+	Vector2 sheepCenter = { wolf.targetPosition.x + cellSize / 2, wolf.targetPosition.y + cellSize / 2 };
+
+	const int segments = 20;
+	const float segmentLength = 5.0f;
+
+	Vector2 direction = { sheepCenter.x - wolfCenter.x, sheepCenter.y - wolfCenter.y };
+
+	float distance = sqrtf(direction.x * direction.x + direction.y * direction.y);
+
+	if (distance <= 0.0f)
+	{
+		return;
+	}
+
+	direction.x /= distance;
+	direction.y /= distance;
+
+	for (int i = 0; i < segments; i += 2)
+	{
+		float startDistance = i * segmentLength;
+
+		if (startDistance >= distance)
+		{
+			break;
+		}
+
+		float endDistance = std::min((i + 1) * segmentLength, distance);
+
+		Vector2 startPosition = { wolfCenter.x + direction.x * startDistance, wolfCenter.y + direction.y * startDistance };
+		Vector2 endPosition = { wolfCenter.x + direction.x * endDistance, wolfCenter.y + direction.y * endDistance };
+
+		DrawLineEx(startPosition, endPosition, 2.0f, { 128, 0, 0, 255 });
+	}
+}
+
+// Connects every grouped sheep near the view with its leader. Leader and member each draw their own line when their activity shows it, colored from their side.
+void WorldRenderer::DrawGroupLines(const RenderSnapshot& snapshot, Rectangle area) const
+{
+	float halfSize = cellSize / 2;
+
+	for (const SheepSnapshot& member : snapshot.sheep)
+	{
+		if (member.leader < 0)
+		{
+			continue;
+		}
+
+		const SheepSnapshot& leader = snapshot.sheep[member.leader];
+
+		Vector2 memberCenter = { member.position.x + halfSize, member.position.y + halfSize };
+		Vector2 leaderCenter = { leader.position.x + halfSize, leader.position.y + halfSize };
+
+		bool eitherReproducing = leader.activity == SheepActivity::Reproducing || member.activity == SheepActivity::Reproducing;
+		bool bothReproducing = leader.activity == SheepActivity::Reproducing && member.activity == SheepActivity::Reproducing;
+		bool eitherEating = leader.activity == SheepActivity::Eating || member.activity == SheepActivity::Eating;
+		bool eitherDefecating = leader.activity == SheepActivity::Defecating || member.activity == SheepActivity::Defecating;
+
+		if (ShowsGroupLine(leader) && CheckCollisionPointRec(leader.position, area))
+		{
+			Color lineColor = bothReproducing ? PINK : eitherReproducing ? Color{ 220, 120, 220, 255 } : eitherEating ? Color{ 102, 51, 153, 255 } : eitherDefecating ? Color{ 255, 128, 0, 255 } : Color{ 25, 25, 153, 255 };
+
+			DrawLine(static_cast<int>(leaderCenter.x), static_cast<int>(leaderCenter.y), static_cast<int>(memberCenter.x), static_cast<int>(memberCenter.y), lineColor);
+		}
+
+		if (ShowsGroupLine(member) && CheckCollisionPointRec(member.position, area))
+		{
+			Color lineColor = bothReproducing ? PINK : eitherReproducing ? Color{ 220, 120, 220, 255 } : eitherEating ? GREEN : eitherDefecating ? ORANGE : BLUE;
+
+			DrawLine(static_cast<int>(memberCenter.x), static_cast<int>(memberCenter.y), static_cast<int>(leaderCenter.x), static_cast<int>(leaderCenter.y), lineColor);
+		}
+	}
+}
+
+// Draws the health and hunger bars of the sheep inside the area in one pass over the snapshot.
+void WorldRenderer::DrawSheepStatusBars(const RenderSnapshot& snapshot, Rectangle area) const
+{
+	const float barWidth = 30.0f;
+	const float barHeight = 4.0f;
+	const float barSpacing = 2.0f;
+
+	const float maxHealth = RuntimeConfig::SheepMaxHealth();
+	const float maxHunger = RuntimeConfig::SheepMaxHunger();
+
+	for (const SheepSnapshot& sheep : snapshot.sheep)
+	{
+		if (!CheckCollisionPointRec(sheep.position, area))
+		{
+			continue;
+		}
+
+		float barX = sheep.position.x + cellSize / 2 - barWidth / 2;
+		float barY = sheep.position.y - 10.0f;
+
+		DrawRectangle(static_cast<int>(barX), static_cast<int>(barY), static_cast<int>(barWidth), static_cast<int>(barHeight), GRAY);
+		DrawRectangle(static_cast<int>(barX), static_cast<int>(barY), static_cast<int>(barWidth * (sheep.health / maxHealth)), static_cast<int>(barHeight), RED);
+
+		DrawRectangle(static_cast<int>(barX), static_cast<int>(barY + barHeight + barSpacing), static_cast<int>(barWidth), static_cast<int>(barHeight), GRAY);
+		DrawRectangle(static_cast<int>(barX), static_cast<int>(barY + barHeight + barSpacing), static_cast<int>(barWidth * (1.0f - sheep.hunger / maxHunger)), static_cast<int>(barHeight), GREEN);
+	}
+}
\ No newline at end of file